@@ -0,0 +1,65 @@
+#include "inicpp.h"
+#include "measure.h"
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace inicpp;
+
+
+namespace
+{
+	/** Number of formatted values in each measurement */
+	const size_t value_count = 1000000;
+
+	/**
+	 * Format all values and print average time of formatting one value.
+	 * @param name description of the formatting method
+	 * @param values formatted values
+	 * @param format function which formats one value and returns length of its text
+	 */
+	template <typename Function>
+	void measure_formatting(const std::string &name, const std::vector<float_ini_t> &values, Function format)
+	{
+		benchmarks::measure(name, values.size(), "value", "characters", [&values, &format](size_t i) {
+			return static_cast<size_t>(format(values[i]));
+		});
+	}
+}
+
+
+/*
+ * Compare formatting of floats with output streams and with shortest round trip formatting.
+ */
+int main()
+{
+	std::mt19937_64 generator(1);
+	std::uniform_real_distribution<float_ini_t> exponent(-20, 20);
+	std::vector<float_ini_t> values;
+	for (size_t i = 0; i < value_count; ++i) {
+		values.push_back(std::pow(10.0, exponent(generator)));
+	}
+
+	std::ostringstream str;
+	measure_formatting("output stream, 6 digits (lossy)", values, [&str](float_ini_t value) {
+		str.str("");
+		str << value;
+		return str.tellp();
+	});
+	str << std::setprecision(std::numeric_limits<float_ini_t>::max_digits10);
+	measure_formatting("output stream, 17 digits", values, [&str](float_ini_t value) {
+		str.str("");
+		str << value;
+		return str.tellp();
+	});
+	char buffer[string_utils::max_formatted_length];
+	measure_formatting("shortest round trip", values, [&buffer](float_ini_t value) {
+		return string_utils::format_value(value, buffer);
+	});
+
+	return 0;
+}
@@ -0,0 +1,50 @@
+#include "inicpp.h"
+#include "measure.h"
+#include <string>
+#include <vector>
+
+using namespace inicpp;
+
+
+namespace
+{
+	/** Number of options in the section */
+	const size_t option_count = 50000;
+	/** Number of lookups in each measurement */
+	const size_t iterations = 1000000;
+
+	/**
+	 * Look up all options of the section repeatedly and print average time of one lookup.
+	 * @param name description of the index
+	 * @param sect searched section
+	 * @param names names of the options in random order
+	 */
+	void measure_lookups(const std::string &name, const section &sect, const std::vector<std::string> &names)
+	{
+		benchmarks::measure(name, iterations, "lookup", "found", [&sect, &names](size_t i) {
+			return sect.find(names[i % names.size()]) != nullptr;
+		});
+	}
+}
+
+
+/*
+ * Compare lookups by name in section with many options for both index policies.
+ */
+int main()
+{
+	std::vector<std::string> names;
+	for (size_t i = 0; i < option_count; ++i) {
+		names.push_back("option_" + std::to_string((i * 7919) % option_count));
+	}
+
+	for (auto policy : {index_policy::ordered, index_policy::hashed}) {
+		section sect("large", policy);
+		for (size_t i = 0; i < option_count; ++i) {
+			sect.add_option<unsigned_ini_t>("option_" + std::to_string(i), i);
+		}
+		measure_lookups(policy == index_policy::ordered ? "ordered index" : "hashed index", sect, names);
+	}
+
+	return 0;
+}
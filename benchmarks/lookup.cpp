@@ -0,0 +1,61 @@
+#include "inicpp.h"
+#include "measure.h"
+#include <string>
+
+using namespace inicpp;
+
+
+namespace
+{
+	/** Number of probes in each measurement */
+	const size_t iterations = 1000000;
+
+	/**
+	 * Run probe function repeatedly and print average time of one call.
+	 * @param name description of the probe
+	 * @param probe function returning number of found values
+	 */
+	template <typename Probe> void measure_probe(const std::string &name, Probe probe)
+	{
+		benchmarks::measure(name, iterations, "probe", "found", [&probe](size_t) { return probe(); });
+	}
+}
+
+
+/*
+ * Compare cost of probing optional settings with exceptions and with
+ * non-throwing find(), try_get() and get_or() functions.
+ */
+int main()
+{
+	config conf = parser::load("[server]\n"
+							   "workers = 16\n"
+							   "timeout = 2.5\n"
+							   "name = main\n");
+	const section &server = conf["server"];
+
+	measure_probe("missing option, operator[] and catch", [&]() -> size_t {
+		try {
+			return server["missing"].get<signed_ini_t>() > 0;
+		} catch (not_found_exception &) {
+			return 0;
+		}
+	});
+	measure_probe("missing option, find()", [&]() -> size_t { return server.find("missing") != nullptr; });
+	measure_probe("malformed value, get() and catch", [&]() -> size_t {
+		try {
+			return server["name"].get<signed_ini_t>() > 0;
+		} catch (bad_cast_exception &) {
+			return 0;
+		}
+	});
+	measure_probe("malformed value, try_get()", [&]() -> size_t {
+		return server.try_get<signed_ini_t>("name").has_value();
+	});
+	measure_probe("present value, get()", [&]() -> size_t { return server["workers"].get<signed_ini_t>() > 0; });
+	measure_probe("present value, get_or()", [&]() -> size_t {
+		return conf.get_or<signed_ini_t>("server", "workers", 1) > 0;
+	});
+
+	return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef INICPP_BENCHMARKS_MEASURE_H
+#define INICPP_BENCHMARKS_MEASURE_H
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace benchmarks
+{
+	/**
+	 * Call function repeatedly and print average duration of one call together with
+	 * average of values returned by the function, which keeps calls from being optimized out.
+	 * Duration is printed in nanoseconds, microseconds, milliseconds or seconds, whichever fits.
+	 * @param name description of the measurement
+	 * @param count number of calls
+	 * @param step name of one call used in printed averages
+	 * @param result name of values returned by the function
+	 * @param function function called with index of the call, returns number of results
+	 */
+	template <typename Function>
+	void measure(
+		const std::string &name, size_t count, const std::string &step, const std::string &result, Function function)
+	{
+		double total = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < count; ++i) {
+			total += function(i);
+		}
+		double average = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / count;
+
+		const char *unit = "s";
+		if (average < 1e-6) {
+			average *= 1e9;
+			unit = "ns";
+		} else if (average < 1e-3) {
+			average *= 1e6;
+			unit = "us";
+		} else if (average < 1) {
+			average *= 1e3;
+			unit = "ms";
+		}
+		std::cout << std::fixed << std::setprecision(2) << name << ": " << average << " " << unit << "/" << step << " ("
+				  << total / count << " " << result << "/" << step << ")" << std::endl;
+	}
+}
+
+#endif // INICPP_BENCHMARKS_MEASURE_H
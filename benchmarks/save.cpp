@@ -0,0 +1,102 @@
+#include "inicpp.h"
+#include "measure.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace inicpp;
+
+
+namespace
+{
+	/** Number of sections in the config */
+	const size_t section_count = 1000;
+	/** Number of options of each type in one section */
+	const size_t option_count = 20;
+	/** Number of writes of whole config in each measurement */
+	const size_t iterations = 20;
+
+	/**
+	 * Write values of an option to the stream the way it was done with streams only,
+	 * every value is read through the list getter and every line is flushed.
+	 * @param os output stream
+	 * @param opt written option
+	 */
+	template <typename ValueType> void write_stream_values(std::ostream &os, const option &opt)
+	{
+		auto values = opt.get_list<ValueType>();
+		for (size_t i = 0; i < values.size(); ++i) {
+			os << (i > 0 ? "," : "") << values[i];
+		}
+	}
+
+	/**
+	 * Write whole config with output streams.
+	 * @param os output stream
+	 * @param cfg written config
+	 */
+	void write_stream(std::ostream &os, const config &cfg)
+	{
+		for (auto &sect : cfg) {
+			os << "[" << sect.get_name() << "]" << std::endl;
+			for (auto &opt : sect) {
+				os << opt.get_name() << " = ";
+				switch (opt.get_type()) {
+				case option_type::signed_e: write_stream_values<signed_ini_t>(os, opt); break;
+				case option_type::unsigned_e: write_stream_values<unsigned_ini_t>(os, opt); break;
+				case option_type::float_e: write_stream_values<float_ini_t>(os, opt); break;
+				default: write_stream_values<string_ini_t>(os, opt); break;
+				}
+				os << std::endl;
+			}
+		}
+	}
+
+	/**
+	 * Run writing function repeatedly and print average time of writing the config.
+	 * @param name description of the writing method
+	 * @param write function which writes the config once and returns size of the output
+	 */
+	template <typename Function> void measure_writes(const std::string &name, Function write)
+	{
+		benchmarks::measure(name, iterations, "config", "bytes", [&write](size_t) { return write(); });
+	}
+}
+
+
+/*
+ * Compare writing of typed config with output streams and with serializer.
+ */
+int main()
+{
+	config cfg;
+	for (size_t i = 0; i < section_count; ++i) {
+		section &sect = cfg.emplace_section("section_" + std::to_string(i));
+		for (size_t j = 0; j < option_count; ++j) {
+			std::string suffix = std::to_string(j);
+			sect.emplace_option("signed_" + suffix).set_list<signed_ini_t>({-static_cast<signed_ini_t>(i * j), 42});
+			sect.add_option<unsigned_ini_t>("unsigned_" + suffix, i * 1000003 + j);
+			sect.emplace_option("float_" + suffix).set_list<float_ini_t>({i / 7.0, j * 1.5e10});
+			sect.add_option<string_ini_t>("string_" + suffix, "value " + suffix);
+		}
+	}
+
+	measure_writes("output stream", [&cfg]() {
+		std::ostringstream str;
+		write_stream(str, cfg);
+		return str.str().size();
+	});
+	measure_writes("serializer to stream", [&cfg]() {
+		std::ostringstream str;
+		parser::save(cfg, str);
+		return str.str().size();
+	});
+	measure_writes("serializer to string", [&cfg]() {
+		std::string output;
+		serializer(output).write(cfg);
+		return output.size();
+	});
+
+	return 0;
+}
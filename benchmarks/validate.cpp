@@ -0,0 +1,93 @@
+#include "inicpp.h"
+#include "measure.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace inicpp;
+
+
+namespace
+{
+	/** Number of sections in the schema and in each config */
+	const size_t section_count = 20;
+	/** Number of options in each section */
+	const size_t option_count = 20;
+	/** Number of validated configs in each measurement */
+	const size_t config_count = 2000;
+
+	/**
+	 * Load configs which are validated, they have values as strings.
+	 * @param text text of the config
+	 * @return independent configs
+	 */
+	std::vector<config> load_configs(const std::string &text)
+	{
+		std::vector<config> configs;
+		for (size_t i = 0; i < config_count; ++i) {
+			configs.push_back(parser::load(text));
+		}
+		return configs;
+	}
+
+	/**
+	 * Validate all configs once by given number of threads and print time of the whole run.
+	 * @param name description of the validation
+	 * @param text text of the config
+	 * @param threads number of threads
+	 * @param validate function validating one config
+	 */
+	template <typename Function>
+	void measure_validation(const std::string &name, const std::string &text, size_t threads, Function validate)
+	{
+		std::vector<config> configs = load_configs(text);
+		std::string description = name + ", " + std::to_string(threads) + " threads";
+		benchmarks::measure(description, 1, "run", "configs", [&configs, &validate, threads](size_t) {
+			std::vector<std::thread> workers;
+			for (size_t t = 0; t < threads; ++t) {
+				workers.emplace_back([&configs, &validate, t, threads]() {
+					for (size_t i = t; i < configs.size(); i += threads) {
+						validate(configs[i]);
+					}
+				});
+			}
+			for (auto &worker : workers) {
+				worker.join();
+			}
+			return configs.size();
+		});
+	}
+}
+
+
+/*
+ * Compare validation of many configs against schema and against compiled schema.
+ */
+int main()
+{
+	schema schm;
+	std::string text;
+	for (size_t i = 0; i < section_count; ++i) {
+		section_schema_params sect_params;
+		sect_params.name = "section_" + std::to_string(i);
+		schm.add_section(sect_params);
+		text += "[" + sect_params.name + "]\n";
+		for (size_t j = 0; j < option_count; ++j) {
+			option_schema_params<unsigned_ini_t> opt_params;
+			opt_params.name = "option_" + std::to_string(j);
+			opt_params.validator = [](unsigned_ini_t value) { return value < 1000000; };
+			schm.add_option(sect_params.name, opt_params);
+			text += opt_params.name + " = " + std::to_string(i * j) + "\n";
+		}
+	}
+	compiled_schema plan = schm.compile();
+
+	for (size_t threads : {1, 2, 4}) {
+		measure_validation(
+			"schema", text, threads, [&schm](config &cfg) { schm.validate_config(cfg, schema_mode::strict); });
+		measure_validation(
+			"compiled schema", text, threads, [&plan](config &cfg) { plan.validate(cfg, schema_mode::strict); });
+	}
+
+	return 0;
+}
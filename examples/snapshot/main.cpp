@@ -0,0 +1,39 @@
+#include "inicpp.h"
+#include <iostream>
+#include <string>
+
+using namespace inicpp;
+
+
+/*
+ * One-shot converter of ini file to binary snapshot. Run it at deploy time,
+ * workers then open the snapshot with snapshot::open() and skip parsing.
+ */
+int main(int argc, char **argv)
+{
+	if (argc != 3) {
+		std::cerr << "Usage: " << argv[0] << " <input.ini> <output.snapshot>" << std::endl;
+		return 1;
+	}
+
+	try {
+		std::cout << "Load and parse config from '" << argv[1] << "'" << std::endl;
+		config conf = parser::load_file(argv[1]);
+
+		std::cout << "Write snapshot to '" << argv[2] << "'" << std::endl;
+		snapshot::write_file(conf, argv[2]);
+
+		// open the snapshot once to check it, including its checksum
+		snapshot snap = snapshot::open(argv[2], true);
+		if (snap.to_config() != conf) {
+			std::cerr << "Written snapshot differs from the config" << std::endl;
+			return 1;
+		}
+		std::cout << "done, " << snap.size() << " sections written..." << std::endl;
+	} catch (inicpp::exception &e) {
+		std::cerr << "Conversion failed: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
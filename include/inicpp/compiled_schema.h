@@ -0,0 +1,201 @@
+#ifndef INICPP_COMPILED_SCHEMA_H
+#define INICPP_COMPILED_SCHEMA_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "dll.h"
+#include "exception.h"
+#include "option_schema.h"
+#include "types.h"
+
+namespace inicpp
+{
+	/** Forward declaration, stated because of ring dependencies */
+	class config;
+	/** Forward declaration, stated because of ring dependencies */
+	class schema;
+	/** Forward declaration, stated because of ring dependencies */
+	class section;
+	/** Forward declaration, stated because of ring dependencies */
+	class section_schema;
+
+
+	/**
+	 * Immutable validation plan created by schema::compile(). Sections and options
+	 * of the schema are flattened into arrays, their names are found through perfect
+	 * hash tables and typed parameters of options are resolved in advance, so every
+	 * section and option of validated config is looked up only once and no casts
+	 * are done during validation. Plan owns a copy of the schema, later changes of
+	 * the source schema do not affect it. Validation does not modify the plan,
+	 * so one plan can validate configs in many threads at once.
+	 */
+	class INICPP_API compiled_schema
+	{
+	private:
+		/** Value returned by lookups if name is not found */
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		/**
+		 * Perfect hash table of names, slots of all tables are in one array.
+		 */
+		struct name_table {
+			/** Seed of hash function which gives no collisions */
+			uint64_t seed = 0;
+			/** Index of the first slot of this table */
+			size_t offset = 0;
+			/** Number of slots minus one, number of slots is power of two */
+			size_t mask = 0;
+		};
+
+		/**
+		 * Precomputed validation of one option.
+		 */
+		struct option_plan {
+			/** Source option_schema, owned by the plan */
+			const option_schema *schema;
+			/** Typed parameters of the option_schema */
+			const option_schema_params_base *params;
+			/** Function running typed validator on all values, nullptr if there is no validator */
+			void (*validate_items)(const option_schema_params_base &params, const option &opt);
+		};
+
+		/**
+		 * Precomputed validation of one section.
+		 */
+		struct section_plan {
+			/** Source section_schema, owned by the plan */
+			const section_schema *schema;
+			/** Index of the first option of this section in option plans */
+			size_t first_option;
+			/** Number of options of this section */
+			size_t option_count;
+			/** Names of the options */
+			name_table options;
+		};
+
+		/** Copy of compiled schema, it owns all referenced schema objects */
+		std::shared_ptr<const schema> schema_;
+		/** Plans of all sections in schema order */
+		std::vector<section_plan> sections_;
+		/** Plans of all options, options of each section are contiguous */
+		std::vector<option_plan> options_;
+		/** Names of the sections */
+		name_table section_names_;
+		/** Slots of all name tables, index of the item increased by one or 0 for empty slot */
+		std::vector<uint32_t> slots_;
+
+		/**
+		 * Construct plan of given schema, it is used by schema::compile().
+		 * @param schm compiled schema
+		 */
+		explicit compiled_schema(const schema &schm);
+		friend class schema;
+
+		/**
+		 * Build perfect hash table of given names and append its slots.
+		 * @param names names of the items, they have to be unique
+		 * @return description of created table
+		 */
+		name_table build_table(const std::vector<std::string_view> &names);
+		/**
+		 * Find name in the table.
+		 * @param table searched table
+		 * @param name searched name
+		 * @param names function returning name of the item on given index
+		 * @return index of the item or npos
+		 */
+		template <typename Names> size_t lookup(const name_table &table, std::string_view name, Names names) const;
+		/**
+		 * Find section plan by name.
+		 * @param section_name name of the section
+		 * @return index of the plan or npos
+		 */
+		size_t find_section(std::string_view section_name) const;
+		/**
+		 * Find option plan of the section by name.
+		 * @param sect_plan plan of the section
+		 * @param option_name name of the option
+		 * @return index of the option within the section or npos
+		 */
+		size_t find_option(const section_plan &sect_plan, std::string_view option_name) const;
+
+		/**
+		 * Validate section against its plan. Section is cloned only
+		 * if it has to be modified and it is shared with a copy of the config.
+		 * @param sect_plan plan of the section
+		 * @param cfg validated config
+		 * @param sect_position position of the section in the config
+		 * @param mode validation mode
+		 * @param found buffer for positions of matched options, it is reused between sections
+		 * @throws validation_exception if section is not valid
+		 */
+		void validate_section(const section_plan &sect_plan,
+			config &cfg,
+			size_t sect_position,
+			schema_mode mode,
+			std::vector<size_t> &found) const;
+		/**
+		 * Validate option against its plan, values are parsed to the type of option_schema.
+		 * @param opt_plan plan of the option
+		 * @param cfg validated config
+		 * @param sect_position position of the section in the config
+		 * @param opt_position position of the option in the section
+		 * @throws validation_exception if option is not valid
+		 */
+		void validate_option(
+			const option_plan &opt_plan, config &cfg, size_t sect_position, size_t opt_position) const;
+		/**
+		 * Run typed validator on all values of the option.
+		 * @param params typed parameters, they have to be option_schema_params<ValueType>
+		 * @param opt validated option
+		 * @throws validation_exception if any value is not valid
+		 */
+		template <typename ValueType>
+		static void validate_typed_items(const option_schema_params_base &params, const option &opt);
+
+	public:
+		/**
+		 * Deleted default constructor.
+		 */
+		compiled_schema() = delete;
+		/**
+		 * Copy constructor, plans share the compiled schema.
+		 */
+		compiled_schema(const compiled_schema &source);
+		/**
+		 * Copy assignment, plans share the compiled schema.
+		 */
+		compiled_schema &operator=(const compiled_schema &source);
+		/**
+		 * Move constructor.
+		 */
+		compiled_schema(compiled_schema &&source) noexcept;
+		/**
+		 * Move assignment.
+		 */
+		compiled_schema &operator=(compiled_schema &&source) noexcept;
+		/**
+		 * Destructor.
+		 */
+		~compiled_schema();
+
+		/**
+		 * Compiled copy of the schema.
+		 * @return constant reference
+		 */
+		const schema &get_schema() const;
+		/**
+		 * Validate cfg in specified mode. Result and reported errors are the same
+		 * as of schema::validate_config() with the compiled schema.
+		 * @param cfg configuration which will be validated
+		 * @param mode validation mode
+		 * @throws validation_exception if config is not valid
+		 */
+		void validate(config &cfg, schema_mode mode) const;
+	};
+}
+
+#endif // INICPP_COMPILED_SCHEMA_H
@@ -3,10 +3,14 @@
 
 #include <iostream>
 #include <map>
+#include <optional>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include "dll.h"
 #include "exception.h"
+#include "name_index.h"
 #include "option.h"
 #include "schema.h"
 #include "section.h"
@@ -16,6 +20,8 @@ namespace inicpp
 {
 	/** Forward declaration, stated because of ring dependencies */
 	class schema;
+	/** Forward declaration, stated because of ring dependencies */
+	class compiled_schema;
 	/** Forward declaration of iterator used in config class */
 	template <typename Element> class config_iterator;
 
@@ -24,21 +30,52 @@ namespace inicpp
 	 * Represents the base object of ini configuration.
 	 * Contains list of sections in logical map structure.
 	 * Can be constructed directly from string or stream.
+	 *
+	 * Copies of config share sections and options, shared nodes are never modified.
+	 * Constant lookups and iteration only read, they return constant references
+	 * and never clone anything. Modifying methods and non-constant access, that is
+	 * non-constant operator[], find(), iterators and mutable_section(), clone
+	 * the section first if it is shared with a copy. Section given out by non-constant
+	 * access is not shared by later copies of this config, so modifications through
+	 * a reference obtained before the copy are not visible in the copy and vice versa.
+	 *
+	 * Constant methods and copying can be used from many threads at once, copies
+	 * can be used and modified by different threads independently. Modifying methods
+	 * and non-constant access need exclusive access to the config, so threads which
+	 * share one config should read it through a constant reference.
 	 */
 	class INICPP_API config
 	{
 	private:
 		using sections_vector = std::vector<std::shared_ptr<section>>;
-		using sections_map = std::map<std::string, std::shared_ptr<section>>;
-		using sections_map_pair = std::pair<std::string, std::shared_ptr<section>>;
 
-		/** List of sections in this config instance */
+		/** List of sections, they can be shared with copies of this config */
 		sections_vector sections_;
-		/** Map of sections for better searching */
-		sections_map sections_map_;
+		/** Index of sections for better searching */
+		name_index<section> index_;
+		/** Flags of sections with modifiable references given out, such sections are cloned by copies */
+		std::vector<bool> exposed_;
+
+		/**
+		 * Section on given position which can be modified, it is cloned first
+		 * if it is shared with a copy of this config. Section is not marked as
+		 * exposed, so returned reference cannot be kept by the caller.
+		 * @param position position of existing section
+		 * @return section owned only by this config
+		 */
+		section &unshared_section(size_t position);
+		/**
+		 * Section with given name which can be modified, see unshared_section(size_t).
+		 * @param section_name name of the section
+		 * @return section owned only by this config
+		 * @throws not_found_exception if section with given name does not exist
+		 */
+		section &unshared_section(std::string_view section_name);
 
 		friend class config_iterator<section>;
 		friend class config_iterator<const section>;
+		friend class schema;
+		friend class compiled_schema;
 
 	public:
 		/** type of iterator */
@@ -51,7 +88,14 @@ namespace inicpp
 		 */
 		config();
 		/**
-		 * Copy constructor.
+		 * Construct empty config with given index policy, sections created
+		 * by this config use the same policy.
+		 * @param policy policy of lookups by name
+		 */
+		explicit config(index_policy policy);
+		/**
+		 * Copy constructor, sections are shared with the source
+		 * except those given out by mutable_section().
 		 */
 		config(const config &source);
 		/**
@@ -61,11 +105,11 @@ namespace inicpp
 		/**
 		 * Move constructor.
 		 */
-		config(config &&source);
+		config(config &&source) noexcept;
 		/**
 		 * Move assignment.
 		 */
-		config &operator=(config &&source);
+		config &operator=(config &&source) noexcept;
 
 		/**
 		 * Add section to this ini configuration.
@@ -73,6 +117,30 @@ namespace inicpp
 		 * @throws ambiguity_exception if section with specified name exists
 		 */
 		void add_section(const section &sect);
+		/**
+		 * Add section to this ini configuration, contents of the section are moved.
+		 * @param sect section which will be added
+		 * @throws ambiguity_exception if section with specified name exists
+		 */
+		void add_section(section &&sect);
+		/**
+		 * Construct section from given arguments directly in this configuration.
+		 * @param args arguments of section constructor, the first one is name
+		 * @return reference to created section
+		 * @throws ambiguity_exception if section with specified name exists
+		 */
+		template <typename... Args> section &emplace_section(Args &&... args)
+		{
+			auto sect = std::make_shared<section>(std::forward<Args>(args)...);
+			if (contains(sect->get_name())) {
+				throw ambiguity_exception(sect->get_name());
+			}
+			sections_.push_back(std::move(sect));
+			index_.push_back(sections_);
+			// returned reference can be kept, so the section is never shared
+			exposed_.push_back(true);
+			return *sections_.back();
+		}
 		/**
 		 * Create and add section with specified name.
 		 * @param section_name section with same name cannot exist in config
@@ -94,6 +162,14 @@ namespace inicpp
 		 * @throws ambiguity_exception if option with specified name exists
 		 */
 		void add_option(const std::string &section_name, const option &opt);
+		/**
+		 * Add given option to specified section, the option is moved.
+		 * @param section_name should exist
+		 * @param opt option which will be added to appropriate section
+		 * @throws not_found_exception if section with given name does not exist
+		 * @throws ambiguity_exception if option with specified name exists
+		 */
+		void add_option(const std::string &section_name, option &&opt);
 		/**
 		 * Creates and add option to specified section.
 		 * @param section_name should exist in this config
@@ -104,14 +180,9 @@ namespace inicpp
 		template <typename ValueType>
 		void add_option(const std::string &section_name, const std::string &option_name, ValueType value)
 		{
-			auto sect_it = sections_map_.find(section_name);
-			if (sect_it != sections_map_.end()) {
-				option opt(option_name);
-				opt.set<ValueType>(value);
-				sect_it->second->add_option(opt);
-			} else {
-				throw not_found_exception(section_name);
-			}
+			option opt(option_name);
+			opt.set<ValueType>(value);
+			unshared_section(section_name).add_option(std::move(opt));
 		}
 
 		/**
@@ -130,7 +201,7 @@ namespace inicpp
 		 */
 		size_t size() const;
 		/**
-		 * Access section on specified index.
+		 * Access section on specified index, see mutable_section(size_t).
 		 * @param index index of requested value
 		 * @return modifiable reference to stored section
 		 * @throws not_found_exception if index is out of range
@@ -144,25 +215,83 @@ namespace inicpp
 		 */
 		const section &operator[](size_t index) const;
 		/**
-		 * Access section with specified name.
+		 * Access section with specified name, see mutable_section(size_t).
 		 * @param section_name name of requested section
 		 * @return modifiable reference to stored section
 		 * @throws not_found_exception if section with given name does not exist
 		 */
-		section &operator[](const std::string &section_name);
+		section &operator[](std::string_view section_name);
 		/**
 		 * Access constant reference on section with specified name.
 		 * @param section_name name of requested section
 		 * @return constant reference to stored section
 		 * @throws not_found_exception if section with given name does not exist
 		 */
-		const section &operator[](const std::string &section_name) const;
+		const section &operator[](std::string_view section_name) const;
 		/**
 		 * Tries to find section with specified name inside this config.
 		 * @param section_name name which is searched
 		 * @return true if section with this name is present, false otherwise
 		 */
-		bool contains(const std::string &section_name) const;
+		bool contains(std::string_view section_name) const;
+		/**
+		 * Find section with specified name, no exception is thrown.
+		 * Found section is accessed in the same way as by mutable_section(size_t).
+		 * @param section_name name which is searched
+		 * @return pointer to stored section or nullptr if there is no such section
+		 */
+		section *find(std::string_view section_name);
+		/**
+		 * Find section with specified name, no exception is thrown.
+		 * @param section_name name which is searched
+		 * @return pointer to stored section or nullptr if there is no such section
+		 */
+		const section *find(std::string_view section_name) const;
+		/**
+		 * Access section on specified index for modification. Section shared
+		 * with a copy of this config is cloned first and it will not be shared
+		 * by later copies, so the reference affects only this config.
+		 * @param index index of requested section
+		 * @return modifiable reference to stored section
+		 * @throws not_found_exception if index is out of range
+		 */
+		section &mutable_section(size_t index);
+		/**
+		 * Access section with specified name for modification, see mutable_section(size_t).
+		 * @param section_name name of requested section
+		 * @return modifiable reference to stored section
+		 * @throws not_found_exception if section with given name does not exist
+		 */
+		section &mutable_section(std::string_view section_name);
+		/**
+		 * Get value of option in given section without throwing exceptions.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @return value or empty optional if option does not exist or it cannot be converted
+		 */
+		template <typename ReturnType>
+		std::optional<ReturnType> try_get(std::string_view section_name, std::string_view option_name) const
+		{
+			const section *sect = find(section_name);
+			if (sect == nullptr) {
+				return std::nullopt;
+			}
+			return sect->try_get<ReturnType>(option_name);
+		}
+		/**
+		 * Get value of option in given section or given default one.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @param default_value value returned if option cannot be read
+		 * @return stored or default value
+		 */
+		template <typename ReturnType>
+		ReturnType get_or(std::string_view section_name, std::string_view option_name, ReturnType default_value) const
+		{
+			const section *sect = find(section_name);
+			return (sect == nullptr ? std::move(default_value) :
+									  sect->get_or<ReturnType>(option_name, std::move(default_value)));
+		}
 
 		/**
 		 * Validates this config agains given schema.
@@ -171,6 +300,13 @@ namespace inicpp
 		 * @throws validation_exception if error occured
 		 */
 		void validate(const schema &schm, schema_mode mode);
+		/**
+		 * Validates this config against compiled schema.
+		 * @param plan compiled schema, see schema::compile()
+		 * @param mode validation mode
+		 * @throws validation_exception if error occured
+		 */
+		void validate(const compiled_schema &plan, schema_mode mode);
 
 		/**
 		 * Equality operator.
@@ -186,14 +322,15 @@ namespace inicpp
 		bool operator!=(const config &other) const;
 
 		/**
-		* Iterator pointing at the beginning of sections list.
-		* @return config_iterator
-		*/
+		 * Iterator pointing at the beginning of sections list,
+		 * sections are accessed in the same way as by mutable_section(size_t).
+		 * @return config_iterator
+		 */
 		iterator begin();
 		/**
-		* Iterator pointing at the end of sections list.
-		* @return config_iterator
-		*/
+		 * Iterator pointing at the end of sections list.
+		 * @return config_iterator
+		 */
 		iterator end();
 		/**
 		 * Constant iterator pointing at the beginning of sections list.
@@ -231,19 +368,31 @@ namespace inicpp
 	/**
 	 * Templated config iterator.
 	 * Templates provide const and non-const iterator in one implementation.
-	 * For easier implementation inheritance from std::iterator is used.
+	 * Non-constant iterator accesses sections through config::mutable_section().
+	 * Iterator traits are stated explicitly, std::iterator is deprecated since C++17.
 	 */
-	template <typename Element> class config_iterator : public std::iterator<std::random_access_iterator_tag, Element>
+	template <typename Element> class config_iterator
 	{
 	private:
+		/** Iterated container, constant for constant iterator */
+		using container_type = typename std::conditional<std::is_const<Element>::value, const config, config>::type;
+
 		/** Reference to container which can be iterated */
-		config &container_;
+		container_type &container_;
 		/** Position in iterable container */
 		size_t position_;
 
 	public:
-		using typename std::iterator<std::random_access_iterator_tag, Element>::reference;
-		using typename std::iterator<std::random_access_iterator_tag, Element>::pointer;
+		/** Category of this iterator */
+		using iterator_category = std::random_access_iterator_tag;
+		/** Type of iterated element */
+		using value_type = Element;
+		/** Type of difference between two iterators */
+		using difference_type = std::ptrdiff_t;
+		/** Pointer to iterated element */
+		using pointer = Element *;
+		/** Reference to iterated element */
+		using reference = Element &;
 
 		/**
 		 * Deleted default constructor.
@@ -272,14 +421,14 @@ namespace inicpp
 		 * @param source container which can be iterated
 		 * @param position initial position to given container
 		 */
-		config_iterator(config &source, size_t position) : container_(source), position_(position)
+		config_iterator(container_type &source, size_t position) : container_(source), position_(position)
 		{
 		}
 		/**
 		 * Construct iterator on given container pointing at the start.
 		 * @param source container which can be iterated
 		 */
-		config_iterator(config &source) : config_iterator(source, 0)
+		config_iterator(container_type &source) : config_iterator(source, 0)
 		{
 		}
 
@@ -337,7 +486,12 @@ namespace inicpp
 		 */
 		reference operator*()
 		{
-			return *container_.sections_.at(position_);
+			if constexpr (std::is_const<Element>::value) {
+				return *container_.sections_.at(position_);
+			} else {
+				// modifiable iterator gives out sections in the same way as mutable_section()
+				return container_.mutable_section(position_);
+			}
 		}
 
 		/**
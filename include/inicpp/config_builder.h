@@ -0,0 +1,95 @@
+#ifndef INICPP_CONFIG_BUILDER_H
+#define INICPP_CONFIG_BUILDER_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "dll.h"
+#include "parse_handler.h"
+#include "schema.h"
+
+namespace inicpp
+{
+	/** Forward declaration of internal graph of links */
+	class link_resolver;
+
+
+	/**
+	 * Handler which constructs config from events of the parser.
+	 * Links to options are recorded while parsing and resolved when
+	 * the config is built, so they can point to any option in the config.
+	 * If builder has a schema, values of options described by the schema are parsed
+	 * into their types once links are resolved, so links see the same text as without
+	 * schema, and built config is validated against the schema.
+	 */
+	class INICPP_API config_builder : public parse_handler
+	{
+	private:
+		/** Constructed config */
+		config cfg_;
+		/** Section which is being filled */
+		std::shared_ptr<section> last_section_;
+		/** Options with unresolved links */
+		std::unique_ptr<link_resolver> links_;
+		/** Validation schema, nullptr if config is not validated */
+		const schema *schema_;
+		/** Validation mode */
+		schema_mode mode_;
+		/** Index policy of built config and its sections */
+		index_policy policy_;
+		/** Schema of the section which is being filled, nullptr if it has none */
+		const section_schema *section_schema_;
+		/** Options described by schema, they are parsed to their types after links are resolved */
+		std::vector<std::pair<option *, const option_schema *>> typed_options_;
+
+		/**
+		 * Store cached section to the config.
+		 */
+		void flush_section();
+
+	public:
+		/**
+		 * Construct empty builder.
+		 * @param policy index policy of built config and its sections
+		 */
+		explicit config_builder(index_policy policy = index_policy::ordered);
+		/**
+		 * Construct empty builder which validates built config.
+		 * @param schm validation schema, it has to outlive the builder
+		 * @param mode validation mode
+		 * @param policy index policy of built config and its sections
+		 */
+		config_builder(const schema &schm, schema_mode mode, index_policy policy = index_policy::ordered);
+		/**
+		 * Destructor.
+		 */
+		~config_builder();
+
+		/**
+		 * Creates section with given name and stores the previous one.
+		 * @param name name of the section
+		 */
+		void on_section(std::string_view name) override;
+		/**
+		 * Adds option to the current section, links in its values are recorded.
+		 * @param name name of the option
+		 * @param values option values, they are moved to created option
+		 */
+		void on_option(std::string_view name, std::vector<std::string> &values) override;
+
+		/**
+		 * Finish construction, resolve links, parse values to types given by schema
+		 * and validate the config if builder has schema, return constructed config.
+		 * Builder is left empty and can be used again.
+		 * @return config with all parsed sections
+		 * @throws parser_exception if link cannot be resolved or links form a cycle
+		 * @throws invalid_type_exception if value does not match type given by schema
+		 * @throws validation_exception if config does not comply schema
+		 */
+		config build();
+	};
+}
+
+#endif // INICPP_CONFIG_BUILDER_H
@@ -0,0 +1,61 @@
+#ifndef INICPP_IDENTIFIER_VALIDATOR_H
+#define INICPP_IDENTIFIER_VALIDATOR_H
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "dll.h"
+
+namespace inicpp
+{
+	/**
+	 * Checks names of sections and options. Allowed characters are stored
+	 * in precomputed 256 entry table, so validation is one linear pass
+	 * without any allocation regardless of configured character sets.
+	 */
+	class INICPP_API identifier_validator
+	{
+	private:
+		/** Table flag of characters allowed at the beginning of identifier */
+		static constexpr unsigned char first_flag = 1;
+		/** Table flag of characters allowed in the rest of identifier */
+		static constexpr unsigned char other_flag = 2;
+
+		/** Character classes indexed by unsigned value of character */
+		std::array<unsigned char, 256> table_;
+
+		/**
+		 * Set given flag to all characters from given set.
+		 * @param chars character set, ranges like 'a-z' are supported
+		 * @param flag flag which will be set
+		 */
+		void add_chars(std::string_view chars, unsigned char flag);
+
+	public:
+		/**
+		 * Construct validator with default inicpp rules, which are equivalent to
+		 * regular expression "^[a-zA-Z.$:][-a-zA-Z0-9_~.:$ ]*$".
+		 */
+		identifier_validator();
+		/**
+		 * Construct validator with custom rules. Character sets are written
+		 * in the same way as regular expression bracket expressions without
+		 * the brackets, so "a-zA-Z_" allows letters and underscore. Dash at
+		 * the start or at the end of the set is taken literally.
+		 * @param first_chars characters allowed at the beginning of identifier
+		 * @param other_chars characters allowed on other positions
+		 */
+		identifier_validator(std::string_view first_chars, std::string_view other_chars);
+
+		/**
+		 * Determines if given identifier fulfils rules of this instance.
+		 * Empty identifier is never valid.
+		 * @param str checked identifier
+		 * @return true if identifier is valid
+		 */
+		bool is_valid(std::string_view str) const;
+	};
+}
+
+#endif // INICPP_IDENTIFIER_VALIDATOR_H
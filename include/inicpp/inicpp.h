@@ -6,14 +6,26 @@
  * library from external projekt.
  */
 
+#include "compiled_schema.h"
 #include "config.h"
+#include "config_builder.h"
 #include "exception.h"
+#include "identifier_validator.h"
+#include "lazy_config.h"
+#include "load_params.h"
+#include "name_index.h"
+#include "parse_handler.h"
 #include "option.h"
 #include "option_schema.h"
 #include "parser.h"
+#include "push_parser.h"
+#include "save_params.h"
 #include "schema.h"
+#include "selection.h"
 #include "section.h"
 #include "section_schema.h"
+#include "serializer.h"
+#include "snapshot.h"
 #include "types.h"
 
 #endif // INICPP_MAIN_H
@@ -0,0 +1,292 @@
+#ifndef INICPP_LAZY_CONFIG_H
+#define INICPP_LAZY_CONFIG_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dll.h"
+#include "exception.h"
+#include "load_params.h"
+#include "schema.h"
+#include "section.h"
+
+namespace inicpp
+{
+	/** Forward declaration of internal file mapping */
+	class mapped_file;
+	/** Forward declaration of internal graph of links */
+	class link_resolver;
+	/** Forward declaration of iterator used in lazy_config class */
+	class lazy_config_iterator;
+
+
+	/**
+	 * Ini configuration which is parsed on demand. Loading only scans the input
+	 * for section headers and records name and byte range of each section. Section
+	 * is parsed (and validated against its schema) on first access by name, index
+	 * or iteration, so startup cost depends on used sections, not on the input size.
+	 * Input stays owned by the instance (as a string or a file mapping) for its lifetime.
+	 * Malformed section headers and duplicate sections are reported by loading,
+	 * errors in section bodies on first access of the section.
+	 * Links of the section are resolved on its access too,
+	 * linked sections are parsed as needed. Class is not thread safe,
+	 * even access to already parsed sections has to be synchronized.
+	 */
+	class INICPP_API lazy_config
+	{
+	private:
+		/**
+		 * Position of one section in the input.
+		 */
+		struct section_entry {
+			/** Name of the section */
+			std::string name;
+			/** Offset of section header in the input, npos for sections added from schema */
+			size_t begin;
+			/** End of the section in the input */
+			size_t end;
+			/** Number of lines before the section header */
+			size_t line_offset;
+			/** Parsed section, nullptr until the section is accessed */
+			std::unique_ptr<section> parsed;
+			/** Index of the first option with links of this section in the link graph */
+			size_t first_link;
+			/** Index after the last option with links of this section in the link graph */
+			size_t last_link;
+			/** True if section was already validated against schema */
+			bool validated;
+		};
+
+		/** Handler which fills one section */
+		class section_builder;
+
+		/** Input owned by this instance if it is not mapped */
+		std::string buffer_;
+		/** Mapping of input file */
+		std::shared_ptr<mapped_file> mapping_;
+		/** Loading parameters */
+		load_params params_;
+		/** Validation schema, nullptr if sections are not validated */
+		std::unique_ptr<schema> schema_;
+		/** Validation mode */
+		schema_mode mode_;
+		/** Sections in order of appearance */
+		std::vector<section_entry> entries_;
+		/** Indexes of sections by their names */
+		std::map<std::string, size_t, std::less<>> index_;
+		/** Options with links of parsed sections */
+		std::unique_ptr<link_resolver> links_;
+
+		friend class parser;
+
+		/**
+		 * Construct empty instance, it is filled by parser.
+		 * @param params loading parameters
+		 */
+		explicit lazy_config(const load_params &params);
+
+		/**
+		 * Input text of the configuration.
+		 * @return view to owned buffer or file mapping
+		 */
+		std::string_view text() const;
+		/**
+		 * Scan the input and find all sections in it.
+		 * @param schm validation schema or nullptr
+		 * @param mode validation mode
+		 * @throws parser_exception if section header is wrong or there is option outside of section
+		 * @throws ambiguity_exception if there are sections with the same name
+		 * @throws validation_exception if names of sections do not comply schema
+		 */
+		void build_index(const schema *schm, schema_mode mode);
+		/**
+		 * Parse section on given index if it was not accessed yet.
+		 * Links in the section are recorded, but not resolved.
+		 * @param index index of the section
+		 * @return reference to parsed section
+		 * @throws parser_exception if section is wrong
+		 */
+		section &parse_section(size_t index);
+		/**
+		 * Get section on given index, parse it and resolve its links if needed.
+		 * @param index index of the section
+		 * @return reference to parsed section
+		 * @throws parser_exception if section is wrong or its links cannot be resolved
+		 * @throws validation_exception if section does not comply schema
+		 */
+		section &get_section(size_t index);
+
+	public:
+		/** type of iterator */
+		using iterator = lazy_config_iterator;
+
+		/**
+		 * Deleted default constructor.
+		 */
+		lazy_config() = delete;
+		/**
+		 * Deleted copy constructor.
+		 */
+		lazy_config(const lazy_config &source) = delete;
+		/**
+		 * Deleted copy assignment.
+		 */
+		lazy_config &operator=(const lazy_config &source) = delete;
+		/**
+		 * Move constructor.
+		 */
+		lazy_config(lazy_config &&source);
+		/**
+		 * Move assignment.
+		 */
+		lazy_config &operator=(lazy_config &&source);
+		/**
+		 * Destructor.
+		 */
+		~lazy_config();
+
+		/**
+		 * Returns number of sections, no section is parsed.
+		 * @return unsigned integer
+		 */
+		size_t size() const;
+		/**
+		 * Access section on specified index, section is parsed if needed.
+		 * @param index index of requested section
+		 * @return modifiable reference to stored section
+		 * @throws not_found_exception if index is out of range
+		 * @throws parser_exception if section is wrong
+		 * @throws validation_exception if section does not comply schema
+		 */
+		section &operator[](size_t index);
+		/**
+		 * Access section with specified name, section is parsed if needed.
+		 * @param section_name name of requested section
+		 * @return modifiable reference to stored section
+		 * @throws not_found_exception if section with given name does not exist
+		 * @throws parser_exception if section is wrong
+		 * @throws validation_exception if section does not comply schema
+		 */
+		section &operator[](std::string_view section_name);
+		/**
+		 * Tries to find section with specified name, no section is parsed.
+		 * @param section_name name which is searched
+		 * @return true if section with this name is present, false otherwise
+		 */
+		bool contains(std::string_view section_name) const;
+		/**
+		 * Determines if section with given name was already parsed.
+		 * @param section_name name of the section
+		 * @return true if section was accessed and parsed
+		 * @throws not_found_exception if section with given name does not exist
+		 */
+		bool is_parsed(std::string_view section_name) const;
+
+		/**
+		 * Iterator pointing at the beginning of sections list.
+		 * @return lazy_config_iterator
+		 */
+		iterator begin();
+		/**
+		 * Iterator pointing at the end of sections list.
+		 * @return lazy_config_iterator
+		 */
+		iterator end();
+	};
+
+
+	/**
+	 * Iterator over sections of lazy_config, section is parsed when iterator is dereferenced.
+	 */
+	class INICPP_API lazy_config_iterator
+	{
+	private:
+		/** Reference to container which can be iterated */
+		lazy_config &container_;
+		/** Position in iterable container */
+		size_t position_;
+
+	public:
+		/** Category of this iterator */
+		using iterator_category = std::forward_iterator_tag;
+		/** Type of iterated element */
+		using value_type = section;
+		/** Type of difference between two iterators */
+		using difference_type = std::ptrdiff_t;
+		/** Pointer to iterated element */
+		using pointer = section *;
+		/** Reference to iterated element */
+		using reference = section &;
+
+		/**
+		 * Construct iterator on given container
+		 * and pointing at specified postion.
+		 * @param source container which can be iterated
+		 * @param position initial position to given container
+		 */
+		lazy_config_iterator(lazy_config &source, size_t position) : container_(source), position_(position)
+		{
+		}
+
+		/**
+		 * Moves iterator to next position.
+		 * @return iterator itself
+		 */
+		lazy_config_iterator &operator++()
+		{
+			++position_;
+			return *this;
+		}
+		/**
+		 * Moves iterator to next position.
+		 * @return new iterator with old position
+		 */
+		lazy_config_iterator operator++(int)
+		{
+			lazy_config_iterator old(*this);
+			operator++();
+			return old;
+		}
+
+		/**
+		 * Equality compare method for iterators.
+		 * @param second
+		 * @return true if iterators are the same
+		 */
+		bool operator==(const lazy_config_iterator &second) const
+		{
+			return &container_ == &second.container_ && position_ == second.position_;
+		}
+		/**
+		 * Non-equality compare method for iterators.
+		 * @param second
+		 * @return true if iterators are different
+		 */
+		bool operator!=(const lazy_config_iterator &second) const
+		{
+			return !(*this == second);
+		}
+
+		/**
+		 * Iterator dereference operator, section is parsed if needed.
+		 * @return reference to section on current position
+		 */
+		reference operator*()
+		{
+			return container_[position_];
+		}
+		/**
+		 * Iterator -> operator
+		 * @return pointer to section on current position
+		 */
+		pointer operator->()
+		{
+			return &container_[position_];
+		}
+	};
+}
+
+#endif // INICPP_LAZY_CONFIG_H
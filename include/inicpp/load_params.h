@@ -0,0 +1,29 @@
+#ifndef INICPP_LOAD_PARAMS_H
+#define INICPP_LOAD_PARAMS_H
+
+#include "identifier_validator.h"
+#include "selection.h"
+#include "types.h"
+
+namespace inicpp
+{
+	/**
+	 * Parameters which can tune loading of ini configuration.
+	 */
+	struct load_params {
+		/** Rules which names of sections and options have to fulfil */
+		identifier_validator identifiers;
+		/**
+		 * Number of threads used for loading of contiguous input, 0 means number of hardware threads.
+		 * Input is split between threads at section boundaries, small inputs and streams
+		 * are always loaded sequentially.
+		 */
+		size_t threads = 1;
+		/** Sections and options which are loaded, others are skipped by lexer */
+		selection selected;
+		/** Index of loaded config and its sections, hashed one suits sections with many options */
+		index_policy index = index_policy::ordered;
+	};
+}
+
+#endif // INICPP_LOAD_PARAMS_H
@@ -0,0 +1,172 @@
+#ifndef INICPP_NAME_INDEX_H
+#define INICPP_NAME_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types.h"
+
+namespace inicpp
+{
+	/**
+	 * Index of named items kept in ordered vector, used by config and section.
+	 * Index maps names to positions in the vector according to its policy.
+	 * Ordered policy keeps names in std::map. Hashed policy uses open addressing
+	 * table with linear probing, which holds only hash and position of each item
+	 * and compares names directly with the items, so names are not stored twice.
+	 * Vector is not owned by the index, it is passed to every call.
+	 */
+	template <typename Item> class name_index
+	{
+	private:
+		using items_vector = std::vector<std::shared_ptr<Item>>;
+
+		/**
+		 * One slot of hash table.
+		 */
+		struct slot {
+			/** Lower bits of hash of the name */
+			uint32_t hash;
+			/** Position of the item plus one, zero marks empty slot */
+			uint32_t position;
+		};
+
+		/** Smallest size of hash table */
+		static constexpr size_t min_capacity = 16;
+
+		/** Policy of this index */
+		index_policy policy_;
+		/** Positions of items by names, used by ordered policy */
+		std::map<std::string, size_t, std::less<>> tree_;
+		/** Hash table with size of power of two, used by hashed policy */
+		std::vector<slot> slots_;
+
+		/**
+		 * Hash of the name.
+		 * @param name name of item
+		 * @return lower bits of the hash
+		 */
+		static uint32_t hash(std::string_view name)
+		{
+			return static_cast<uint32_t>(std::hash<std::string_view>()(name));
+		}
+		/**
+		 * Store item to the first free slot of its probe sequence.
+		 * @param name_hash hash of the name of item
+		 * @param position position of the item
+		 */
+		void insert_slot(uint32_t name_hash, size_t position)
+		{
+			size_t mask = slots_.size() - 1;
+			size_t i = name_hash & mask;
+			while (slots_[i].position != 0) {
+				i = (i + 1) & mask;
+			}
+			slots_[i] = slot{name_hash, static_cast<uint32_t>(position + 1)};
+		}
+		/**
+		 * Build hash table of given size from all items.
+		 * @param items indexed items
+		 * @param capacity new size of the table, power of two
+		 */
+		void rehash(const items_vector &items, size_t capacity)
+		{
+			slots_.assign(capacity, slot{0, 0});
+			for (size_t i = 0; i < items.size(); ++i) {
+				insert_slot(hash(items[i]->get_name()), i);
+			}
+		}
+
+	public:
+		/** Position returned if item is not found */
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		/**
+		 * Construct empty index.
+		 * @param policy policy of created index
+		 */
+		explicit name_index(index_policy policy = index_policy::ordered) : policy_(policy)
+		{
+		}
+
+		/**
+		 * Policy of this index.
+		 * @return policy given on construction
+		 */
+		index_policy get_policy() const
+		{
+			return policy_;
+		}
+
+		/**
+		 * Find position of item with given name.
+		 * @param name name of searched item
+		 * @param items indexed items
+		 * @return position of the item or npos if there is no such item
+		 */
+		size_t find(std::string_view name, const items_vector &items) const
+		{
+			if (policy_ == index_policy::ordered) {
+				auto it = tree_.find(name);
+				return (it == tree_.end() ? npos : it->second);
+			}
+
+			if (slots_.empty()) {
+				return npos;
+			}
+			uint32_t name_hash = hash(name);
+			size_t mask = slots_.size() - 1;
+			for (size_t i = name_hash & mask; slots_[i].position != 0; i = (i + 1) & mask) {
+				if (slots_[i].hash == name_hash && items[slots_[i].position - 1]->get_name() == name) {
+					return slots_[i].position - 1;
+				}
+			}
+			return npos;
+		}
+
+		/**
+		 * Add the last item of the vector to the index.
+		 * @param items indexed items, the last one was just appended
+		 */
+		void push_back(const items_vector &items)
+		{
+			if (policy_ == index_policy::ordered) {
+				tree_.emplace(items.back()->get_name(), items.size() - 1);
+			} else if (items.size() * 2 > slots_.size()) {
+				// table is at most half full, so probe sequences stay short
+				rehash(items, std::max(min_capacity, slots_.size() * 2));
+			} else {
+				insert_slot(hash(items.back()->get_name()), items.size() - 1);
+			}
+		}
+
+		/**
+		 * Remove item from the index.
+		 * @param name name of removed item
+		 * @param position position on which the item was
+		 * @param items indexed items, the removed one is already erased
+		 */
+		void erase(std::string_view name, size_t position, const items_vector &items)
+		{
+			if (policy_ == index_policy::ordered) {
+				tree_.erase(tree_.find(name));
+				// items after the removed one moved by one position
+				for (auto &entry : tree_) {
+					if (entry.second > position) {
+						entry.second--;
+					}
+				}
+			} else {
+				rehash(items, slots_.size());
+			}
+		}
+	};
+}
+
+#endif // INICPP_NAME_INDEX_H
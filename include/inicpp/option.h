@@ -1,9 +1,14 @@
 #ifndef INICPP_OPTION_H
 #define INICPP_OPTION_H
 
+#include <atomic>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <variant>
 #include <vector>
 
 #include "dll.h"
@@ -11,7 +16,6 @@
 #include "option_schema.h"
 #include "string_utils.h"
 #include "types.h"
-#include "types.h"
 
 
 namespace inicpp
@@ -22,7 +26,7 @@ namespace inicpp
 
 	/**
 	 * Base class for option_value objects,
-	 * which allows storing templated option values in option instance.
+	 * which allows storing templated values in one container.
 	 */
 	class option_holder
 	{
@@ -47,7 +51,7 @@ namespace inicpp
 		 * Construct option_value with given value.
 		 * @param value value which will be stored
 		 */
-		option_value(ValueType value) : value_(value)
+		option_value(ValueType value) : value_(std::move(value))
 		{
 		}
 		/**
@@ -98,18 +102,14 @@ namespace inicpp
 			/**
 			 * Get value of type ActualType from value argument and try to convert it
 			 * to ReturnType.
-			 * @param value Pointer to internal representation of option value
+			 * @param value Internal representation of option value
 			 * @return Converted option value
 			 * @throws bad_cast_exception if such cast cannot be made
 			 */
-			static ReturnType get_converted_value(const std::unique_ptr<option_holder> &value)
+			static ReturnType get_converted_value(const ActualType &value)
 			{
-				option_value<ActualType> *ptr = dynamic_cast<option_value<ActualType> *>(&*value);
-				if (ptr == nullptr) {
-					throw bad_cast_exception("Cannot cast to requested type");
-				}
 				try {
-					return static_cast<ReturnType>(ptr->get());
+					return static_cast<ReturnType>(value);
 				} catch (std::runtime_error &e) {
 					throw bad_cast_exception(e.what());
 				}
@@ -122,17 +122,104 @@ namespace inicpp
 		template <typename ActualType> class convertor<ActualType, string_ini_t>
 		{
 		public:
-			static string_ini_t get_converted_value(const std::unique_ptr<option_holder> &value)
+			static string_ini_t get_converted_value(const ActualType &value)
 			{
-				option_value<ActualType> *ptr = dynamic_cast<option_value<ActualType> *>(&*value);
-				if (ptr == nullptr) {
-					throw bad_cast_exception("Cannot cast to requested type");
-				}
-				return inistd::to_string(ptr->get());
+				return inistd::to_string(value);
 			}
 		};
 	} // anonymous namespace
 
+
+	/**
+	 * Cache of the first value of string option converted to boolean or numeric types.
+	 * Cache is filled from const getters, which can be called from more threads
+	 * at once, so entries are published through atomics and no lock is taken.
+	 * Copied cache is always empty, owner has to clear it on every modification.
+	 */
+	class conversion_cache
+	{
+	private:
+		/** Bit on position of option_type is set if its entry holds a value */
+		std::atomic<unsigned> valid_;
+		/** Bits of cached values, indexed by option_type */
+		std::atomic<uint64_t> entries_[4];
+
+		/**
+		 * Determines if values of given type can be cached.
+		 * @return true for boolean and numeric types
+		 */
+		template <typename ValueType> static constexpr bool is_cached_type()
+		{
+			return std::is_same<ValueType, boolean_ini_t>::value || std::is_same<ValueType, signed_ini_t>::value ||
+				std::is_same<ValueType, unsigned_ini_t>::value || std::is_same<ValueType, float_ini_t>::value;
+		}
+
+	public:
+		/**
+		 * Construct empty cache.
+		 */
+		conversion_cache() noexcept : valid_(0)
+		{
+		}
+		/**
+		 * Copy constructor, constructs empty cache.
+		 */
+		conversion_cache(const conversion_cache &) noexcept : conversion_cache()
+		{
+		}
+		/**
+		 * Copy assignment, clears the cache.
+		 */
+		conversion_cache &operator=(const conversion_cache &) noexcept
+		{
+			clear();
+			return *this;
+		}
+
+		/**
+		 * Drop all cached values.
+		 */
+		void clear() noexcept
+		{
+			valid_.store(0, std::memory_order_relaxed);
+		}
+		/**
+		 * Get cached value of given type.
+		 * @param value set to cached value if there is one
+		 * @return true if value was found
+		 */
+		template <typename ValueType> bool load(ValueType &value) const
+		{
+			if constexpr (!is_cached_type<ValueType>()) {
+				return false;
+			} else {
+				unsigned bit = 1u << static_cast<unsigned>(get_option_enum_type<ValueType>());
+				if ((valid_.load(std::memory_order_acquire) & bit) == 0) {
+					return false;
+				}
+				uint64_t bits = entries_[static_cast<size_t>(get_option_enum_type<ValueType>())].load(
+					std::memory_order_relaxed);
+				std::memcpy(&value, &bits, sizeof(value));
+				return true;
+			}
+		}
+		/**
+		 * Store value of given type, other types are ignored.
+		 * @param value converted value
+		 */
+		template <typename ValueType> void store(const ValueType &value)
+		{
+			if constexpr (is_cached_type<ValueType>()) {
+				uint64_t bits = 0;
+				std::memcpy(&bits, &value, sizeof(value));
+				size_t index = static_cast<size_t>(get_option_enum_type<ValueType>());
+				// concurrent readers store the same bits, so the entry is never torn
+				entries_[index].store(bits, std::memory_order_relaxed);
+				valid_.fetch_or(1u << index, std::memory_order_release);
+			}
+		}
+	};
+
 	/**
 	 * Represent ini configuration option.
 	 * Can store one element or list of elements.
@@ -143,54 +230,90 @@ namespace inicpp
 	private:
 		/** Name of this ini option */
 		std::string name_;
-		/** Type of this ini option */
-		option_type type_;
-		/** Values which corresponds with this option */
-		std::vector<std::unique_ptr<option_holder>> values_;
+		/**
+		 * Values of this option in one contiguous array of their type. Index
+		 * of the alternative is the option_type of the values, so type
+		 * is checked without RTTI and values are read without indirection.
+		 */
+		std::variant<std::vector<boolean_ini_t>,
+			std::vector<signed_ini_t>,
+			std::vector<unsigned_ini_t>,
+			std::vector<float_ini_t>,
+			std::vector<enum_ini_t>,
+			std::vector<string_ini_t>>
+			values_;
 		/** Corresponding option_schema if any */
 		std::shared_ptr<option_schema> option_schema_;
+		/** Typed reads of string value, filled by const getters */
+		mutable conversion_cache cache_;
 
-		/** Save copy of opt option into self */
-		template <typename ValueType> void copy_option(const std::unique_ptr<option_holder> &opt)
+		/**
+		 * Determines if values of given type can be stored in option.
+		 * @return true if type is one of *_ini_t types
+		 */
+		template <typename ValueType> static constexpr bool is_stored_type()
 		{
-			option_value<ValueType> *ptr = dynamic_cast<option_value<ValueType> *>(&*opt);
-			auto new_option_value = std::make_unique<option_value<ValueType>>(ptr->get());
-			values_.push_back(std::move(new_option_value));
+			return std::is_same<ValueType, boolean_ini_t>::value || std::is_same<ValueType, signed_ini_t>::value ||
+				std::is_same<ValueType, unsigned_ini_t>::value || std::is_same<ValueType, float_ini_t>::value ||
+				std::is_same<ValueType, enum_ini_t>::value || std::is_same<ValueType, string_ini_t>::value;
 		}
 
-		/** Compare local and remote option values, both of ValueType type. */
-		template <typename ValueType>
-		bool compare_option(
-			const std::unique_ptr<option_holder> &local, const std::unique_ptr<option_holder> &remote) const
+		/**
+		 * Get stored values if they have given type.
+		 * @return pointer to values or nullptr if option has other type
+		 */
+		template <typename ValueType> std::vector<ValueType> *typed_values()
+		{
+			if constexpr (is_stored_type<ValueType>()) {
+				return std::get_if<std::vector<ValueType>>(&values_);
+			} else {
+				return nullptr;
+			}
+		}
+		/**
+		 * Get stored values if they have given type.
+		 * @return pointer to values or nullptr if option has other type
+		 */
+		template <typename ValueType> const std::vector<ValueType> *typed_values() const
 		{
-			option_value<ValueType> *loc = dynamic_cast<option_value<ValueType> *>(&*local);
-			option_value<ValueType> *rem = dynamic_cast<option_value<ValueType> *>(&*remote);
-			return loc->get() == rem->get();
+			if constexpr (is_stored_type<ValueType>()) {
+				return std::get_if<std::vector<ValueType>>(&values_);
+			} else {
+				return nullptr;
+			}
 		}
 
-		template <typename ReturnType>
-		ReturnType convert_single_value(option_type source_type, const std::unique_ptr<option_holder> &value) const
+		/**
+		 * Number of stored values.
+		 * @return unsigned integer
+		 */
+		size_t values_size() const;
+
+		template <typename ReturnType> ReturnType convert_single_value(size_t index) const
 		{
-			switch (source_type) {
-			case option_type::boolean_e: return convertor<boolean_ini_t, ReturnType>::get_converted_value(value); break;
-			case option_type::enum_e: return convertor<enum_ini_t, ReturnType>::get_converted_value(value); break;
-			case option_type::float_e: return convertor<float_ini_t, ReturnType>::get_converted_value(value); break;
-			case option_type::signed_e: return convertor<signed_ini_t, ReturnType>::get_converted_value(value); break;
+			switch (get_type()) {
+			case option_type::boolean_e:
+				return convertor<boolean_ini_t, ReturnType>::get_converted_value(std::get<0>(values_)[index]);
+				break;
+			case option_type::enum_e:
+				return convertor<enum_ini_t, ReturnType>::get_converted_value(std::get<4>(values_)[index]);
+				break;
+			case option_type::float_e:
+				return convertor<float_ini_t, ReturnType>::get_converted_value(std::get<3>(values_)[index]);
+				break;
+			case option_type::signed_e:
+				return convertor<signed_ini_t, ReturnType>::get_converted_value(std::get<1>(values_)[index]);
+				break;
 			case option_type::string_e: {
-				option_value<string_ini_t> *ptr = dynamic_cast<option_value<string_ini_t> *>(&*value);
-				if (ptr == nullptr) {
-					throw bad_cast_exception("Cannot cast to requested type");
-				}
-
 				// We have string, so try to parse it
 				try {
-					return string_utils::parse_string<ReturnType>(ptr->get(), get_name());
+					return string_utils::parse_string<ReturnType>(std::get<5>(values_)[index], get_name());
 				} catch (invalid_type_exception &e) {
 					throw bad_cast_exception(e.what());
 				}
 			} break;
 			case option_type::unsigned_e:
-				return convertor<unsigned_ini_t, ReturnType>::get_converted_value(value);
+				return convertor<unsigned_ini_t, ReturnType>::get_converted_value(std::get<2>(values_)[index]);
 				break;
 			case option_type::invalid_e:
 			default:
@@ -200,6 +323,11 @@ namespace inicpp
 			}
 		}
 
+		friend class serializer;
+		friend class compiled_schema;
+		friend class option_schema;
+		friend class snapshot;
+
 	public:
 		/**
 		 * Default constructor is deleted.
@@ -216,11 +344,11 @@ namespace inicpp
 		/**
 		 * Move constructor.
 		 */
-		option(option &&source);
+		option(option &&source) noexcept;
 		/**
 		 * Move assignment.
 		 */
-		option &operator=(option &&source);
+		option &operator=(option &&source) noexcept;
 
 		/**
 		 * Construct ini option with specified value of specified type.
@@ -234,6 +362,13 @@ namespace inicpp
 		 * @param values initial value
 		 */
 		option(const std::string &name, const std::vector<std::string> &values);
+		/**
+		 * Construct ini option with specified value of specified list type.
+		 * Given values are moved into the option instead of copied.
+		 * @param name name of newly created option
+		 * @param values initial value
+		 */
+		option(const std::string &name, std::vector<std::string> &&values);
 
 		/**
 		 * Gets this option name.
@@ -314,12 +449,80 @@ namespace inicpp
 		 */
 		template <typename ReturnType> ReturnType get() const
 		{
-			if (values_.empty()) {
+			if (values_size() == 0) {
 				throw not_found_exception(0);
 			}
 
-			// Get the value and try to convert it
-			return convert_single_value<ReturnType>(type_, values_[0]);
+			// value of the same type is just read, other types are converted
+			if (auto values = typed_values<ReturnType>()) {
+				return (*values)[0];
+			}
+			if (get_type() != option_type::string_e) {
+				return convert_single_value<ReturnType>(0);
+			}
+
+			// parsed strings are remembered, so repeated reads cost the same as typed ones
+			ReturnType value;
+			if (!cache_.load(value)) {
+				value = convert_single_value<ReturnType>(0);
+				cache_.store(value);
+			}
+			return value;
+		}
+
+		/**
+		 * Get single element value without throwing exceptions.
+		 * Strings are parsed into booleans and numbers, values of other types
+		 * are converted as in get().
+		 * @return value or empty optional if option has no value or it cannot be converted
+		 */
+		template <typename ReturnType> std::optional<ReturnType> try_get() const
+		{
+			static_assert(is_stored_type<ReturnType>(), "Option values cannot be read in requested type");
+			if (values_size() == 0) {
+				return std::nullopt;
+			}
+			if (auto values = typed_values<ReturnType>()) {
+				return (*values)[0];
+			}
+
+			option_type type = get_type();
+			if constexpr (std::is_same<ReturnType, string_ini_t>::value) {
+				return convert_single_value<ReturnType>(0);
+			} else if constexpr (std::is_same<ReturnType, enum_ini_t>::value) {
+				// only strings can be read as enums
+				if (type != option_type::string_e) {
+					return std::nullopt;
+				}
+				return enum_ini_t(std::get<5>(values_)[0]);
+			} else {
+				if (type == option_type::enum_e) {
+					return std::nullopt;
+				}
+				if (type != option_type::string_e) {
+					return convert_single_value<ReturnType>(0);
+				}
+
+				ReturnType value;
+				if (!cache_.load(value)) {
+					if (string_utils::parse_value(std::get<5>(values_)[0], value) != string_utils::parse_status::ok) {
+						return std::nullopt;
+					}
+					cache_.store(value);
+				}
+				return value;
+			}
+		}
+
+		/**
+		 * Get single element value or given default one, no exception is thrown.
+		 * @param default_value value returned if option cannot be read in requested type
+		 * @return stored or default value
+		 */
+		template <typename ReturnType> ReturnType get_or(ReturnType default_value) const
+		{
+			std::optional<ReturnType> value = try_get<ReturnType>();
+			return (value ? std::move(*value) : std::move(default_value));
 		}
 
 		/**
@@ -332,10 +535,11 @@ namespace inicpp
 		 */
 		template <typename ValueType> void set_list(const std::vector<ValueType> &list)
 		{
-			values_.clear();
-			type_ = get_option_enum_type<ValueType>();
-			for (const auto &item : list) {
-				add_to_list(item);
+			if constexpr (!is_stored_type<ValueType>()) {
+				throw bad_cast_exception("Cannot cast to requested type");
+			} else {
+				values_ = list;
+				cache_.clear();
 			}
 		}
 
@@ -349,12 +553,18 @@ namespace inicpp
 		 */
 		template <typename ReturnType> std::vector<ReturnType> get_list() const
 		{
-			if (values_.empty()) {
+			size_t size = values_size();
+			if (size == 0) {
 				throw not_found_exception(0);
 			}
+			if (auto values = typed_values<ReturnType>()) {
+				return *values;
+			}
+
 			std::vector<ReturnType> results;
-			for (const auto &value : values_) {
-				results.push_back(convert_single_value<ReturnType>(type_, value));
+			results.reserve(size);
+			for (size_t i = 0; i < size; ++i) {
+				results.push_back(convert_single_value<ReturnType>(i));
 			}
 
 			return results;
@@ -368,11 +578,12 @@ namespace inicpp
 		 */
 		template <typename ValueType> void add_to_list(ValueType value)
 		{
-			if (get_option_enum_type<ValueType>() != type_) {
+			auto values = typed_values<ValueType>();
+			if (values == nullptr) {
 				throw bad_cast_exception("Cannot cast to requested type");
 			}
-			auto new_option_value = std::make_unique<option_value<ValueType>>(value);
-			values_.push_back(std::move(new_option_value));
+			values->push_back(std::move(value));
+			cache_.clear();
 		}
 
 		/**
@@ -385,14 +596,15 @@ namespace inicpp
 		 */
 		template <typename ValueType> void add_to_list(ValueType value, size_t position)
 		{
-			if (get_option_enum_type<ValueType>() != type_) {
+			auto values = typed_values<ValueType>();
+			if (values == nullptr) {
 				throw bad_cast_exception("Cannot cast to requested type");
 			}
-			if (position > values_.size()) {
+			if (position > values->size()) {
 				throw not_found_exception(position);
 			}
-			auto new_option_value = std::make_unique<option_value<ValueType>>(value);
-			values_.insert(values_.begin() + position, std::move(new_option_value));
+			values->insert(values->begin() + position, std::move(value));
+			cache_.clear();
 		}
 
 		/**
@@ -402,13 +614,14 @@ namespace inicpp
 		 */
 		template <typename ValueType> void remove_from_list(ValueType value)
 		{
-			if (get_option_enum_type<ValueType>() != type_) {
+			auto values = typed_values<ValueType>();
+			if (values == nullptr) {
 				throw bad_cast_exception("Cannot cast to requested type");
 			}
-			for (auto it = values_.cbegin(); it != values_.cend(); ++it) {
-				option_value<ValueType> *ptr = dynamic_cast<option_value<ValueType> *>(&*(*it));
-				if (ptr->get() == value) {
-					values_.erase(it);
+			for (auto it = values->begin(); it != values->end(); ++it) {
+				if (*it == value) {
+					values->erase(it);
+					cache_.clear();
 					break;
 				}
 			}
@@ -86,16 +86,11 @@ namespace inicpp
 		 */
 		void validate_option_items(option &opt) const;
 
-		template <typename ValueType>
-		void validate_typed_option_items(const std::vector<ValueType> &items, const std::string &option_name) const
-		{
-			for (const auto &item : items) {
-				option_schema_params<ValueType> *ptr = dynamic_cast<option_schema_params<ValueType> *>(&*params_);
-				if (ptr != nullptr && ptr->validator != nullptr && !ptr->validator(item)) {
-					throw validation_exception("Option '" + option_name + "' - validation failed");
-				}
-			}
-		}
+		/**
+		 * Run validator of given type on all items in option.
+		 * @param opt validated option
+		 */
+		template <typename ValueType> void validate_typed_option_items(const option &opt) const;
 
 		void parse_option_items(option &opt) const;
 
@@ -111,6 +106,8 @@ namespace inicpp
 			return typed_items;
 		}
 
+		friend class compiled_schema;
+
 	public:
 		/**
 		 * Deleted default constructor.
@@ -127,11 +124,11 @@ namespace inicpp
 		/**
 		 * Move constructor.
 		 */
-		option_schema(option_schema &&source);
+		option_schema(option_schema &&source) noexcept;
 		/**
 		 * Move assignment.
 		 */
-		option_schema &operator=(option_schema &&source);
+		option_schema &operator=(option_schema &&source) noexcept;
 
 		/**
 		 * Construct option_schema from given parameters.
@@ -185,6 +182,15 @@ namespace inicpp
 		 * @throws validation_exception if error occured
 		 */
 		void validate_option(option &opt) const;
+		/**
+		 * Parse textual values of the option to the type of this option_schema
+		 * without copying them. If the number of values does not match
+		 * this option_schema, values are kept as strings and the mismatch
+		 * is reported by validate_option().
+		 * @param opt option with textual values
+		 * @throws invalid_type_exception if value cannot be parsed to the type
+		 */
+		void parse_option(option &opt) const;
 
 		/**
 		 * To given output stream writes additional information about option.
@@ -0,0 +1,77 @@
+#ifndef INICPP_PARSE_HANDLER_H
+#define INICPP_PARSE_HANDLER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dll.h"
+#include "exception.h"
+
+namespace inicpp
+{
+	/** Forward declarations, parsers set position of the handler */
+	class parser;
+	class push_parser;
+
+
+	/**
+	 * Receiver of events generated by streaming parser. Input is lexed line
+	 * by line and events are emitted immediately, no config object graph is built,
+	 * so arbitrarily large input can be processed in constant memory.
+	 * All methods have default implementation, so only interesting events
+	 * has to be overridden.
+	 */
+	class INICPP_API parse_handler
+	{
+	private:
+		/** Number of currently processed line */
+		size_t line_number_ = 0;
+
+		friend class parser;
+		friend class push_parser;
+
+	public:
+		/**
+		 * Stated for completion.
+		 */
+		virtual ~parse_handler()
+		{
+		}
+
+		/**
+		 * Called at the start of each section.
+		 * @param name unescaped and validated name of the section, valid only during this call
+		 */
+		virtual void on_section(std::string_view name);
+		/**
+		 * Called for every option. Values are split to list and unescaped. Links
+		 * are validated but passed unresolved as "${section#option}" text, because
+		 * streaming parser does not keep values of previous options.
+		 * @param name unescaped and validated name of the option, valid only during this call
+		 * @param values list of option values, handler can move them out
+		 */
+		virtual void on_option(std::string_view name, std::vector<std::string> &values);
+		/**
+		 * Called for every comment, either on separate line or at the end of line.
+		 * @param comment trimmed text of comment without leading semicolon, valid only during this call
+		 */
+		virtual void on_comment(std::string_view comment);
+		/**
+		 * Called when malformed line is encountered. If this method returns,
+		 * the rest of the line is skipped and parsing continues.
+		 * @param message description of the error including line number
+		 * @param line_number number of malformed line
+		 * @throws parser_exception by default implementation
+		 */
+		virtual void on_error(const std::string &message, size_t line_number);
+
+		/**
+		 * Number of currently processed line, counted from one.
+		 * @return line number
+		 */
+		size_t get_line_number() const;
+	};
+}
+
+#endif // INICPP_PARSE_HANDLER_H
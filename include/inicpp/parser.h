@@ -3,19 +3,29 @@
 
 #include <fstream>
 #include <iostream>
-#include <regex>
-#include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "config.h"
+#include "config_builder.h"
 #include "dll.h"
 #include "exception.h"
+#include "identifier_validator.h"
+#include "lazy_config.h"
+#include "load_params.h"
+#include "parse_handler.h"
+#include "save_params.h"
 #include "schema.h"
+#include "selection.h"
 #include "string_utils.h"
 
 namespace inicpp
 {
+	/** Forward declaration of internal lexer helper */
+	class scanner;
+
+
 	/**
 	 * Parser is not constructable class which contains methods
 	 * which can be used to load or store ini configuration.
@@ -28,24 +38,104 @@ namespace inicpp
 		 * Escaping character is '\'
 		 * @return std::string::npos if not found
 		 */
-		static size_t find_first_nonescaped(const std::string &str, char ch);
+		static size_t find_first_nonescaped(std::string_view str, char ch);
 		/**
-		 * Finds last escaped character given as parameter
-		 * Escaping character is '\'
-		 * @return std::string::npos if not found
+		 * Remove escaping characters from given string. If there is nothing
+		 * to unescape, @a str itself is returned and no copy is made.
+		 * @param str escaped string
+		 * @param buffer storage for unescaped string if one has to be created
+		 * @return view to @a str or to @a buffer
+		 */
+		static std::string_view unescape(std::string_view str, std::string &buffer);
+		/**
+		 * Split option value on given range of scanned text to list of values.
+		 * Delimiters are taken from scanner masks, text is not searched again.
+		 * @param sc scanner of the text
+		 * @param begin start of option value
+		 * @param end end of option value (exclusive)
+		 * @param result list which is filled with unescaped values
+		 */
+		static void parse_option_list(scanner &sc, size_t begin, size_t end, std::vector<std::string> &result);
+		/**
+		 * Determines if given option value is link to other option.
+		 * @param value option value
+		 * @return true if value has format "${...}"
+		 */
+		static bool is_link(std::string_view value);
+		/**
+		 * Split link in format "${section#option}" to its parts.
+		 * @param value option value which is link
+		 * @param sect_link name of linked section
+		 * @param opt_link name of linked option
+		 * @return description of the error if link is malformed, nullptr otherwise
+		 */
+		static const char *split_link(std::string_view value, std::string_view &sect_link, std::string_view &opt_link);
+
+		/**
+		 * State of the lexer which is carried between lines.
+		 */
+		struct line_state {
+			/** True if there is opened section */
+			bool in_section = false;
+			/** True if current section is not selected and its lines are skipped */
+			bool skipping = false;
+			/** Name of current section, it is stored only if options are filtered */
+			std::string section_name;
+			/** Reusable storage of option values */
+			std::vector<std::string> values;
+		};
+
+		/**
+		 * Determines if given line starts a section, nothing else is checked.
+		 * @param line line without newline character
+		 * @return true if first non-whitespace character is '['
+		 */
+		static bool starts_section(std::string_view line);
+		/**
+		 * Lex one line of ini configuration and emit events to given handler.
+		 * @param sc scanner of the text which contains the line
+		 * @param begin start of the line in scanned text
+		 * @param end end of the line without terminating newline character
+		 * @param handler receiver of events, its line number has to be set
+		 * @param state state of the lexer
+		 * @param params loading parameters
+		 */
+		static void parse_line(scanner &sc,
+			size_t begin,
+			size_t end,
+			parse_handler &handler,
+			line_state &state,
+			const load_params &params);
+		/**
+		 * Lex given text line by line and emit events to given handler.
+		 * @param str ini configuration description
+		 * @param handler receiver of events
+		 * @param params loading parameters
+		 * @param line_offset number of lines which precede @a str in the whole input
 		 */
-		static size_t find_last_escaped(const std::string &str, char ch);
-		static std::string unescape(const std::string &str);
-		static std::string delete_comment(const std::string &str);
-		static std::vector<std::string> parse_option_list(const std::string &str);
-		static void handle_links(const config &cfg,
-			const section &last_section,
-			std::vector<std::string> &option_val_list,
-			size_t line_number);
-		static void validate_identifier(const std::string &str, size_t line_number);
+		static void internal_parse(
+			std::string_view str, parse_handler &handler, const load_params &params, size_t line_offset = 0);
+		static void internal_parse(std::istream &str, parse_handler &handler, const load_params &params);
 
-		static config internal_load(std::istream &str);
-		static void internal_save(const config &cfg, const schema &schm, std::ostream &str);
+		/**
+		 * Load config from given text, values of options are parsed to types given by schema.
+		 * @param str ini configuration description
+		 * @param schm validation schema or nullptr
+		 * @param mode validation mode
+		 * @param params loading parameters
+		 */
+		static config internal_load(
+			std::string_view str, const schema *schm, schema_mode mode, const load_params &params);
+		static config internal_load(std::istream &str, const schema *schm, schema_mode mode, const load_params &params);
+		static config load_file(
+			const std::string &file, const schema *schm, schema_mode mode, const load_params &params);
+		static lazy_config load_file_lazy(
+			const std::string &file, const schema *schm, schema_mode mode, const load_params &params);
+
+		friend class lazy_config;
+		friend class link_resolver;
+		friend class push_parser;
+		friend class parallel_loader;
 
 	public:
 		/**
@@ -71,70 +161,198 @@ namespace inicpp
 
 		/**
 		 * Load ini configuration from given string and return it.
+		 * Configuration is parsed directly from given contiguous buffer,
+		 * which is owned by the caller and has to live only during this call.
 		 * @param str ini configuration description
+		 * @param params loading parameters
 		 * @return newly created config class
 		 * @throws parser_exception if ini configuration is wrong
 		 */
-		static config load(const std::string &str);
+		static config load(std::string_view str, const load_params &params = load_params());
 		/**
 		 * Load ini configuration from given string
 		 * and validate it through schema.
 		 * @param str ini configuration description
 		 * @param schm validation schema
 		 * @param mode validation mode
+		 * @param params loading parameters
 		 * @return constructed config class which comply given schema
 		 * @throws parser_exception if ini configuration is wrong
 		 * @throws validation_exception if configuration does not comply schema
 		 */
-		static config load(const std::string &str, const schema &schm, schema_mode mode);
+		static config load(
+			std::string_view str, const schema &schm, schema_mode mode, const load_params &params = load_params());
 		/**
 		 * Load ini configuration from given stream and return it.
 		 * @param str ini configuration description
+		 * @param params loading parameters
 		 * @return newly created config class
 		 * @throws parser_exception if ini configuration is wrong
 		 */
-		static config load(std::istream &str);
+		static config load(std::istream &str, const load_params &params = load_params());
 		/**
 		 * Load ini configuration from given stream
 		 * and validate it through schema.
 		 * @param str ini configuration description
 		 * @param schm validation schema
 		 * @param mode validation mode
+		 * @param params loading parameters
 		 * @return constructed config class which comply given schema
 		 * @throws parser_exception if ini configuration is wrong
 		 * @throws validation_exception if configuration does not comply schema
 		 */
-		static config load(std::istream &str, const schema &schm, schema_mode mode);
+		static config load(
+			std::istream &str, const schema &schm, schema_mode mode, const load_params &params = load_params());
 
 		/**
 		 * Load ini configuration from file with specified name.
+		 * Regular files are memory mapped and parsed directly from the mapping,
+		 * other files (pipes, devices) are read as a stream.
 		 * @param file name of file which contains ini configuration
+		 * @param params loading parameters
 		 * @return new instance of config class
 		 * @throws parser_exception if ini configuration is wrong
 		 */
-		static config load_file(const std::string &file);
+		static config load_file(const std::string &file, const load_params &params = load_params());
 		/**
 		 * Load ini configuration from file with specified name
 		 * and validate it against given schema.
 		 * @param file name of file with ini configuration
 		 * @param schm validation schema
 		 * @param mode validation mode
+		 * @param params loading parameters
 		 * @return new instance of config class
 		 * @throws parser_exception if ini configuration is wrong
 		 * @throws validation_exception if configuration does not comply schema
 		 */
-		static config load_file(const std::string &file, const schema &schm, schema_mode mode);
+		static config load_file(const std::string &file,
+			const schema &schm,
+			schema_mode mode,
+			const load_params &params = load_params());
+
+		/**
+		 * Load only selected sections and options of ini configuration from given string.
+		 * Other sections are skipped by lexer without being validated or allocated.
+		 * @param str ini configuration description
+		 * @param sel selected sections and options
+		 * @param params loading parameters, their selection is replaced by @a sel
+		 * @return newly created config class with selected sections
+		 * @throws parser_exception if selected part of ini configuration is wrong
+		 */
+		static config load(std::string_view str, const selection &sel, const load_params &params = load_params());
+		/**
+		 * Load only selected sections and options of ini configuration from given stream.
+		 * @param str ini configuration description
+		 * @param sel selected sections and options
+		 * @param params loading parameters, their selection is replaced by @a sel
+		 * @return newly created config class with selected sections
+		 * @throws parser_exception if selected part of ini configuration is wrong
+		 */
+		static config load(std::istream &str, const selection &sel, const load_params &params = load_params());
+		/**
+		 * Load only selected sections and options of ini configuration from file with specified name.
+		 * @param file name of file which contains ini configuration
+		 * @param sel selected sections and options
+		 * @param params loading parameters, their selection is replaced by @a sel
+		 * @return newly created config class with selected sections
+		 * @throws parser_exception if selected part of ini configuration is wrong
+		 */
+		static config load_file(
+			const std::string &file, const selection &sel, const load_params &params = load_params());
+
+		/**
+		 * Load ini configuration lazily from given string. Only section headers
+		 * are parsed now, sections are parsed on first access.
+		 * @param str ini configuration description, it is owned by returned instance
+		 * @param params loading parameters
+		 * @return lazily parsed configuration
+		 * @throws parser_exception if section header is wrong
+		 * @throws ambiguity_exception if there are sections with the same name
+		 */
+		static lazy_config load_lazy(std::string str, const load_params &params = load_params());
+		/**
+		 * Load ini configuration lazily from given string. Presence of sections
+		 * is validated now, contents of sections on first access.
+		 * @param str ini configuration description, it is owned by returned instance
+		 * @param schm validation schema, it is copied to returned instance
+		 * @param mode validation mode
+		 * @param params loading parameters
+		 * @return lazily parsed configuration
+		 * @throws parser_exception if section header is wrong
+		 * @throws ambiguity_exception if there are sections with the same name
+		 * @throws validation_exception if sections do not comply schema
+		 */
+		static lazy_config load_lazy(
+			std::string str, const schema &schm, schema_mode mode, const load_params &params = load_params());
+		/**
+		 * Load ini configuration lazily from file with specified name. Regular files
+		 * are memory mapped, so pages of sections which are not accessed are not touched again.
+		 * @param file name of file which contains ini configuration
+		 * @param params loading parameters
+		 * @return lazily parsed configuration
+		 * @throws parser_exception if file cannot be read or section header is wrong
+		 * @throws ambiguity_exception if there are sections with the same name
+		 */
+		static lazy_config load_file_lazy(const std::string &file, const load_params &params = load_params());
+		/**
+		 * Load ini configuration lazily from file with specified name and validate it
+		 * against given schema when sections are accessed.
+		 * @param file name of file which contains ini configuration
+		 * @param schm validation schema, it is copied to returned instance
+		 * @param mode validation mode
+		 * @param params loading parameters
+		 * @return lazily parsed configuration
+		 * @throws parser_exception if file cannot be read or section header is wrong
+		 * @throws ambiguity_exception if there are sections with the same name
+		 * @throws validation_exception if sections do not comply schema
+		 */
+		static lazy_config load_file_lazy(const std::string &file,
+			const schema &schm,
+			schema_mode mode,
+			const load_params &params = load_params());
+
+		/**
+		 * Parse ini configuration from given string and send its content
+		 * as events to given handler. No config is constructed.
+		 * @param str ini configuration description
+		 * @param handler receiver of parser events
+		 * @param params loading parameters
+		 * @throws parser_exception if ini configuration is wrong and handler does not handle errors
+		 */
+		static void parse(std::string_view str, parse_handler &handler, const load_params &params = load_params());
+		/**
+		 * Parse ini configuration from given stream and send its content
+		 * as events to given handler. Stream is read line by line.
+		 * @param str ini configuration description
+		 * @param handler receiver of parser events
+		 * @param params loading parameters
+		 * @throws parser_exception if ini configuration is wrong and handler does not handle errors
+		 */
+		static void parse(std::istream &str, parse_handler &handler, const load_params &params = load_params());
+		/**
+		 * Parse ini configuration from file with specified name and send its content
+		 * as events to given handler.
+		 * @param file name of file which contains ini configuration
+		 * @param handler receiver of parser events
+		 * @param params loading parameters
+		 * @throws parser_exception if ini configuration is wrong and handler does not handle errors
+		 */
+		static void parse_file(
+			const std::string &file, parse_handler &handler, const load_params &params = load_params());
 
 		/**
 		 * Save given configuration to file.
 		 * @param cfg configuration which will be saved
 		 * @param file name of output file
+		 * @param params saving parameters
+		 * @throws parser_exception if output cannot be written
 		 */
-		static void save(const config &cfg, const std::string &file);
+		static void save(const config &cfg, const std::string &file, const save_params &params = save_params());
 		/**
 		 * Save configuration to output stream.
 		 * @param cfg configuration which will be saved
 		 * @param str output stream
+		 * @throws parser_exception if output cannot be written
 		 */
 		static void save(const config &cfg, std::ostream &str);
 		/**
@@ -143,26 +361,33 @@ namespace inicpp
 		 * @param cfg configuration which will be saved
 		 * @param schm schema which will be saved
 		 * @param file name of output file
+		 * @param params saving parameters
+		 * @throws parser_exception if output cannot be written
 		 */
-		static void save(const config &cfg, const schema &schm, const std::string &file);
+		static void save(
+			const config &cfg, const schema &schm, const std::string &file, const save_params &params = save_params());
 		/**
 		 * Save given configuration (could be only partial) to output stream. Options
 		 * which are not specified will be substitued by default values from schema.
 		 * @param cfg configuration which will be saved
 		 * @param schm schema which will be saved
 		 * @param str output stream
+		 * @throws parser_exception if output cannot be written
 		 */
 		static void save(const config &cfg, const schema &schm, std::ostream &str);
 		/**
 		* Save validation schema to file.
 		* @param schm schema which will be saved
 		* @param file name of output file
+		* @param params saving parameters
+		* @throws parser_exception if output cannot be written
 		*/
-		static void save(const schema &schm, const std::string &file);
+		static void save(const schema &schm, const std::string &file, const save_params &params = save_params());
 		/**
 		* Save given validation schema to output stream.
 		* @param schm schema which will be saved
 		* @param str output stream
+		* @throws parser_exception if output cannot be written
 		*/
 		static void save(const schema &schm, std::ostream &str);
 	};
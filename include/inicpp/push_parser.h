@@ -0,0 +1,85 @@
+#ifndef INICPP_PUSH_PARSER_H
+#define INICPP_PUSH_PARSER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dll.h"
+#include "parse_handler.h"
+#include "parser.h"
+
+namespace inicpp
+{
+	/**
+	 * Incremental parser which accepts ini configuration in chunks of arbitrary size.
+	 * Every complete line is parsed as soon as it is fed and events are emitted
+	 * to the handler immediately, only incomplete last line is kept between chunks.
+	 * Use config_builder as handler to construct config object.
+	 */
+	class INICPP_API push_parser
+	{
+	private:
+		/** Receiver of parser events */
+		parse_handler &handler_;
+		/** Loading parameters */
+		load_params params_;
+		/** Lexer of currently parsed text, owned for reuse of its storage */
+		std::unique_ptr<scanner> scanner_;
+		/** Beginning of the line which was not terminated in previous chunks */
+		std::string pending_;
+		/** State of the lexer */
+		parser::line_state state_;
+		/** Number of lines parsed so far */
+		size_t line_number_;
+
+		/**
+		 * Parse all complete lines in given text.
+		 * @param text chunk of input
+		 * @return position of incomplete last line in @a text
+		 */
+		size_t parse_lines(std::string_view text);
+		/**
+		 * Parse one line which does not contain newline character.
+		 * @param line whole line
+		 */
+		void parse_line(std::string_view line);
+
+	public:
+		/**
+		 * Construct parser which emits events to given handler.
+		 * @param handler receiver of events, it has to outlive the parser
+		 * @param params loading parameters
+		 */
+		explicit push_parser(parse_handler &handler, const load_params &params = load_params());
+		/**
+		 * Destructor.
+		 */
+		~push_parser();
+		/**
+		 * Deleted copy constructor.
+		 */
+		push_parser(const push_parser &source) = delete;
+		/**
+		 * Deleted copy assignment.
+		 */
+		push_parser &operator=(const push_parser &source) = delete;
+
+		/**
+		 * Parse next chunk of input. Chunk can end anywhere,
+		 * even in the middle of the line or escape sequence.
+		 * @param data start of the chunk, it has to live only during this call
+		 * @param size length of the chunk
+		 * @throws parser_exception if handler reports error
+		 */
+		void feed(const char *data, size_t size);
+		/**
+		 * Parse the rest of input which was not terminated by newline.
+		 * Parser is reset afterwards and can be used for next input.
+		 * @throws parser_exception if handler reports error
+		 */
+		void finish();
+	};
+}
+
+#endif // INICPP_PUSH_PARSER_H
@@ -0,0 +1,32 @@
+#ifndef INICPP_SAVE_PARAMS_H
+#define INICPP_SAVE_PARAMS_H
+
+#include <cstddef>
+
+namespace inicpp
+{
+	/**
+	 * Parameters which can tune saving of ini configuration into a file.
+	 */
+	struct save_params {
+		/**
+		 * Write into temporary file in the same directory, flush it to the disk
+		 * and rename it over the target. Readers see either old or new content
+		 * and never partially written file, even if the process or system crashes.
+		 * Existing target is replaced, so symbolic link is replaced by regular file
+		 * and hard links keep the old content. Permissions of the target are kept,
+		 * saving fails if they cannot be copied to the new file.
+		 */
+		bool atomic = false;
+		/**
+		 * Flush directory of the target to the disk after atomic rename,
+		 * so the new file survives a system crash right after saving.
+		 * If this flush fails, saving throws although the target already has new content.
+		 */
+		bool sync_directory = false;
+		/** Size of output buffer in bytes, data are written to the file whenever it is full */
+		size_t buffer_size = 1 << 16;
+	};
+}
+
+#endif // INICPP_SAVE_PARAMS_H
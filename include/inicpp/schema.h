@@ -2,8 +2,10 @@
 #define INICPP_SCHEMA_H
 
 #include <iostream>
+#include <string_view>
 #include <vector>
 
+#include "compiled_schema.h"
 #include "config.h"
 #include "dll.h"
 #include "exception.h"
@@ -25,7 +27,7 @@ namespace inicpp
 	{
 	private:
 		using sect_schema_vector = std::vector<std::shared_ptr<section_schema>>;
-		using sect_schema_map = std::map<std::string, std::shared_ptr<section_schema>>;
+		using sect_schema_map = std::map<std::string, std::shared_ptr<section_schema>, std::less<>>;
 		using sect_schema_map_pair = std::pair<std::string, std::shared_ptr<section_schema>>;
 
 		/** Container for section_schema objects */
@@ -49,11 +51,11 @@ namespace inicpp
 		/**
 		 * Move constructor.
 		 */
-		schema(schema &&source);
+		schema(schema &&source) noexcept;
 		/**
 		 * Move assignment.
 		 */
-		schema &operator=(schema &&source);
+		schema &operator=(schema &&source) noexcept;
 
 		/**
 		 * Adds section from given attribute to internal container.
@@ -61,6 +63,12 @@ namespace inicpp
 		 * @throws ambiguity_exception if section_schema with given name exists
 		 */
 		void add_section(const section_schema &sect_schema);
+		/**
+		 * Adds section to internal container, given section_schema is moved.
+		 * @param sect_schema section_schema object
+		 * @throws ambiguity_exception if section_schema with given name exists
+		 */
+		void add_section(section_schema &&sect_schema);
 		/**
 		 * From given section_schema_params structure
 		 * section_schema is created and added to this scheme.
@@ -77,6 +85,14 @@ namespace inicpp
 		 * @throws ambiguity_exception if option_schema with given name exists
 		 */
 		void add_option(const std::string &section_name, const option_schema &opt_schema);
+		/**
+		 * Adds option to the section_schema with specified name, given option_schema is moved.
+		 * @param section_name name of existing section
+		 * @param opt_schema options_schema which will be added to section
+		 * @throws not_found_exception if section_name does not exist
+		 * @throws ambiguity_exception if option_schema with given name exists
+		 */
+		void add_option(const std::string &section_name, option_schema &&opt_schema);
 		/**
 		 * Creates option_schema from given arguments
 		 * and adds it to specified section.
@@ -90,8 +106,7 @@ namespace inicpp
 		{
 			auto sect_it = sections_map_.find(section_name);
 			if (sect_it != sections_map_.end()) {
-				option_schema opt_schema(arguments);
-				sect_it->second->add_option(opt_schema);
+				sect_it->second->add_option(option_schema(arguments));
 			} else {
 				throw not_found_exception(section_name);
 			}
@@ -122,20 +137,32 @@ namespace inicpp
 		 * @return modifiable reference to stored section_schema
 		 * @throws not_found_exception if section_schema with given name does not exist
 		 */
-		section_schema &operator[](const std::string &section_name);
+		section_schema &operator[](std::string_view section_name);
 		/**
 		 * Access constant reference on section_schema with specified name.
 		 * @param section_name name of requested section_schema
 		 * @return constant reference to stored section_schema
 		 * @throws not_found_exception if section_schema with given name does not exist
 		 */
-		const section_schema &operator[](const std::string &section_name) const;
+		const section_schema &operator[](std::string_view section_name) const;
 		/**
 		 * Tries to find section_schema with specified name inside this config.
 		 * @param section_name name which is searched
 		 * @return true if section_schema with this name is present, false otherwise
 		 */
-		bool contains(const std::string &section_name) const;
+		bool contains(std::string_view section_name) const;
+		/**
+		 * Find section_schema with specified name, no exception is thrown.
+		 * @param section_name name which is searched
+		 * @return pointer to stored section_schema or nullptr if there is no such section
+		 */
+		section_schema *find(std::string_view section_name);
+		/**
+		 * Find section_schema with specified name, no exception is thrown.
+		 * @param section_name name which is searched
+		 * @return pointer to stored section_schema or nullptr if there is no such section
+		 */
+		const section_schema *find(std::string_view section_name) const;
 
 		/**
 		 * Validate cfg against this schema in specified mode.
@@ -144,6 +171,12 @@ namespace inicpp
 		 * @throws validation_exception if schema cannot be validated
 		 */
 		void validate_config(config &cfg, schema_mode mode) const;
+		/**
+		 * Create immutable validation plan of this schema, which validates configs
+		 * faster than validate_config() if the schema is used many times.
+		 * @return plan with a copy of this schema
+		 */
+		compiled_schema compile() const;
 
 		/**
 		 * Classic stream operator for printing this instance to output stream.
@@ -5,10 +5,14 @@
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <optional>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include "dll.h"
 #include "exception.h"
+#include "name_index.h"
 #include "option.h"
 #include "section_schema.h"
 
@@ -23,23 +27,47 @@ namespace inicpp
 	/**
 	 * Represents section from ini format. Can contain multiple options.
 	 * Always should be in config container class.
+	 * Copies of section share options, shared options are never modified.
+	 * Constant lookups and iteration return constant references without cloning,
+	 * modifying methods and non-constant access, that is non-constant operator[],
+	 * find(), iterators and mutable_option(), clone the option first if it is shared.
+	 * Option given out by non-constant access is not shared by later copies of this
+	 * section. Thread safety rules are the same as of config.
 	 */
 	class INICPP_API section
 	{
 	private:
 		using options_vector = std::vector<std::shared_ptr<option>>;
-		using options_map = std::map<std::string, std::shared_ptr<option>>;
-		using options_map_pair = std::pair<std::string, std::shared_ptr<option>>;
 
-		/** List of options in this instance */
+		/** List of options, they can be shared with copies of this section */
 		options_vector options_;
-		/** Map of options for better searching */
-		options_map options_map_;
+		/** Index of options for better searching */
+		name_index<option> index_;
+		/** Flags of options with modifiable references given out, such options are cloned by copies */
+		std::vector<bool> exposed_;
 		/** Name of this section */
 		std::string name_;
 
+		/**
+		 * Option on given position which can be modified, it is cloned first
+		 * if it is shared with a copy of this section. Option is not marked as
+		 * exposed, so returned reference cannot be kept by the caller.
+		 * @param position position of existing option
+		 * @return option owned only by this section
+		 */
+		option &unshared_option(size_t position);
+		/**
+		 * Determines if modifiable reference to any option was given out.
+		 * @return true if some option is exposed
+		 */
+		bool has_exposed_options() const;
+
 		friend class section_iterator<option>;
 		friend class section_iterator<const option>;
+		friend class config;
+		friend class section_schema;
+		friend class compiled_schema;
+		friend class link_resolver;
 
 	public:
 		/** type of iterator */
@@ -52,7 +80,8 @@ namespace inicpp
 		 */
 		section() = delete;
 		/**
-		 * Copy constructor.
+		 * Copy constructor, options are shared with the source
+		 * except those given out by mutable_option().
 		 */
 		section(const section &source);
 		/**
@@ -62,17 +91,18 @@ namespace inicpp
 		/**
 		 * Move constructor.
 		 */
-		section(section &&source);
+		section(section &&source) noexcept;
 		/**
 		 * Move assignment.
 		 */
-		section &operator=(section &&source);
+		section &operator=(section &&source) noexcept;
 
 		/**
 		 * Construct instance of section class with given name.
 		 * @param name name of newly created section class
+		 * @param policy policy of lookups of options by name
 		 */
-		section(const std::string &name);
+		section(const std::string &name, index_policy policy = index_policy::ordered);
 
 		/**
 		 * Getter for name of this section.
@@ -88,12 +118,12 @@ namespace inicpp
 		 */
 		template <typename ValueType> void add_option(const std::string &option_name, ValueType value)
 		{
-			auto add_it = options_map_.find(option_name);
-			if (add_it == options_map_.end()) {
+			if (index_.find(option_name, options_) == index_.npos) {
 				std::shared_ptr<option> opt = std::make_shared<option>(option_name);
 				opt->set<ValueType>(value);
 				options_.push_back(opt);
-				options_map_.insert(options_map_pair(opt->get_name(), opt));
+				index_.push_back(options_);
+				exposed_.push_back(false);
 			} else {
 				throw ambiguity_exception(option_name);
 			}
@@ -104,6 +134,30 @@ namespace inicpp
 		 * @throws ambiguity_exception if option with specified name exists
 		 */
 		void add_option(const option &opt);
+		/**
+		 * Add given option instance to options container, the option is moved.
+		 * @param opt particular instance of option class
+		 * @throws ambiguity_exception if option with specified name exists
+		 */
+		void add_option(option &&opt);
+		/**
+		 * Construct option from given arguments directly in options container.
+		 * @param args arguments of option constructor, the first one is name
+		 * @return reference to created option
+		 * @throws ambiguity_exception if option with specified name exists
+		 */
+		template <typename... Args> option &emplace_option(Args &&... args)
+		{
+			auto opt = std::make_shared<option>(std::forward<Args>(args)...);
+			if (contains(opt->get_name())) {
+				throw ambiguity_exception(opt->get_name());
+			}
+			options_.push_back(std::move(opt));
+			index_.push_back(options_);
+			// returned reference can be kept, so the option is never shared
+			exposed_.push_back(true);
+			return *options_.back();
+		}
 		/**
 		 * From list of options remove the one with specified name
 		 * @param option_name name of option which will be removed
@@ -117,7 +171,7 @@ namespace inicpp
 		 */
 		size_t size() const;
 		/**
-		 * Access option on specified index.
+		 * Access option on specified index, see mutable_option(size_t).
 		 * @param index
 		 * @return modifiable reference to stored option
 		 * @throws not_found_exception in case of out of range
@@ -131,25 +185,78 @@ namespace inicpp
 		 */
 		const option &operator[](size_t index) const;
 		/**
-		 * Access option with specified name
+		 * Access option with specified name, see mutable_option(size_t).
 		 * @param option_name
 		 * @return modifiable reference to stored option
 		 * @throws not_found_exception if option with given name does not exist
 		 */
-		option &operator[](const std::string &option_name);
+		option &operator[](std::string_view option_name);
 		/**
 		 * Access constant reference on option with specified name
 		 * @param option_name
 		 * @return constant reference to stored option
 		 * @throws not_found_exception if option with given name does not exist
 		 */
-		const option &operator[](const std::string &option_name) const;
+		const option &operator[](std::string_view option_name) const;
 		/**
 		 * Tries to find option with specified name inside this section.
 		 * @param option_name name which is searched
 		 * @return true if option with this name is present, false otherwise
 		 */
-		bool contains(const std::string &option_name) const;
+		bool contains(std::string_view option_name) const;
+		/**
+		 * Find option with specified name, no exception is thrown.
+		 * Found option is accessed in the same way as by mutable_option(size_t).
+		 * @param option_name name which is searched
+		 * @return pointer to stored option or nullptr if there is no such option
+		 */
+		option *find(std::string_view option_name);
+		/**
+		 * Find option with specified name, no exception is thrown.
+		 * @param option_name name which is searched
+		 * @return pointer to stored option or nullptr if there is no such option
+		 */
+		const option *find(std::string_view option_name) const;
+		/**
+		 * Access option on specified index for modification. Option shared
+		 * with a copy of this section is cloned first and it will not be shared
+		 * by later copies, so the reference affects only this section.
+		 * @param index index of requested option
+		 * @return modifiable reference to stored option
+		 * @throws not_found_exception in case of out of range
+		 */
+		option &mutable_option(size_t index);
+		/**
+		 * Access option with specified name for modification, see mutable_option(size_t).
+		 * @param option_name name of requested option
+		 * @return modifiable reference to stored option
+		 * @throws not_found_exception if option with given name does not exist
+		 */
+		option &mutable_option(std::string_view option_name);
+		/**
+		 * Get value of option with specified name without throwing exceptions.
+		 * @param option_name name of the option
+		 * @return value or empty optional if option does not exist or it cannot be converted
+		 */
+		template <typename ReturnType> std::optional<ReturnType> try_get(std::string_view option_name) const
+		{
+			const option *opt = find(option_name);
+			if (opt == nullptr) {
+				return std::nullopt;
+			}
+			return opt->try_get<ReturnType>();
+		}
+		/**
+		 * Get value of option with specified name or given default one.
+		 * @param option_name name of the option
+		 * @param default_value value returned if option cannot be read
+		 * @return stored or default value
+		 */
+		template <typename ReturnType> ReturnType get_or(std::string_view option_name, ReturnType default_value) const
+		{
+			const option *opt = find(option_name);
+			return (opt == nullptr ? std::move(default_value) : opt->get_or<ReturnType>(std::move(default_value)));
+		}
 
 		/**
 		 * Validates this section agains given section_schema.
@@ -173,7 +280,8 @@ namespace inicpp
 		bool operator!=(const section &other) const;
 
 		/**
-		 * Iterator pointing at the beginning of options list.
+		 * Iterator pointing at the beginning of options list,
+		 * options are accessed in the same way as by mutable_option(size_t).
 		 * @return section_iterator
 		 */
 		iterator begin();
@@ -217,19 +325,31 @@ namespace inicpp
 	/**
 	 * Templated section iterator.
 	 * Templates provide const and non-const iterator in one implementation.
-	 * For easier implementation inheritance from std::iterator is used.
+	 * Non-constant iterator accesses options through section::mutable_option().
+	 * Iterator traits are stated explicitly, std::iterator is deprecated since C++17.
 	 */
-	template <typename Element> class section_iterator : public std::iterator<std::random_access_iterator_tag, Element>
+	template <typename Element> class section_iterator
 	{
 	private:
+		/** Iterated container, constant for constant iterator */
+		using container_type = typename std::conditional<std::is_const<Element>::value, const section, section>::type;
+
 		/** Reference to container which can be iterated */
-		section &container_;
+		container_type &container_;
 		/** Position in iterable container */
 		size_t position_;
 
 	public:
-		using typename std::iterator<std::random_access_iterator_tag, Element>::reference;
-		using typename std::iterator<std::random_access_iterator_tag, Element>::pointer;
+		/** Category of this iterator */
+		using iterator_category = std::random_access_iterator_tag;
+		/** Type of iterated element */
+		using value_type = Element;
+		/** Type of difference between two iterators */
+		using difference_type = std::ptrdiff_t;
+		/** Pointer to iterated element */
+		using pointer = Element *;
+		/** Reference to iterated element */
+		using reference = Element &;
 
 		/**
 		 * Deleted default constructor.
@@ -258,14 +378,14 @@ namespace inicpp
 		 * @param source container which can be iterated
 		 * @param position initial position to given container
 		 */
-		section_iterator(section &source, size_t position) : container_(source), position_(position)
+		section_iterator(container_type &source, size_t position) : container_(source), position_(position)
 		{
 		}
 		/**
 		 * Construct iterator on given container pointing at the start.
 		 * @param source container which can be iterated
 		 */
-		section_iterator(section &source) : section_iterator(source, 0)
+		section_iterator(container_type &source) : section_iterator(source, 0)
 		{
 		}
 
@@ -314,7 +434,12 @@ namespace inicpp
 		 */
 		reference operator*()
 		{
-			return *container_.options_.at(position_);
+			if constexpr (std::is_const<Element>::value) {
+				return *container_.options_.at(position_);
+			} else {
+				// modifiable iterator gives out options in the same way as mutable_option()
+				return container_.mutable_option(position_);
+			}
 		}
 
 		/**
@@ -2,6 +2,7 @@
 #define INICPP_SECTION_SCHEMA_H
 
 #include <iostream>
+#include <string_view>
 #include <vector>
 
 #include "dll.h"
@@ -38,7 +39,7 @@ namespace inicpp
 	{
 	private:
 		using opt_schema_vector = std::vector<std::shared_ptr<option_schema>>;
-		using opt_schema_map = std::map<std::string, std::shared_ptr<option_schema>>;
+		using opt_schema_map = std::map<std::string, std::shared_ptr<option_schema>, std::less<>>;
 		using opt_schema_map_pair = std::pair<std::string, std::shared_ptr<option_schema>>;
 
 		/** Section name */
@@ -69,11 +70,11 @@ namespace inicpp
 		/**
 		 * Move constructor.
 		 */
-		section_schema(section_schema &&source);
+		section_schema(section_schema &&source) noexcept;
 		/**
 		 * Move assignment.
 		 */
-		section_schema &operator=(section_schema &&source);
+		section_schema &operator=(section_schema &&source) noexcept;
 
 		/**
 		 * Construct section_schema from given arguments.
@@ -103,6 +104,12 @@ namespace inicpp
 		 * @throws ambiguity_exception if option_schema with given name exists
 		 */
 		void add_option(const option_schema &opt);
+		/**
+		 * Add option_schema to options list, given option_schema is moved.
+		 * @param opt option_schema which will be added to this instance
+		 * @throws ambiguity_exception if option_schema with given name exists
+		 */
+		void add_option(option_schema &&opt);
 		/**
 		 * Creates option_schema from given arguments and add it to options list.
 		 * @param arguments creation paramaters
@@ -151,20 +158,32 @@ namespace inicpp
 		 * @return modifiable reference to stored option_schema
 		 * @throws not_found_exception if option_schema with given name does not exist
 		 */
-		option_schema &operator[](const std::string &option_name);
+		option_schema &operator[](std::string_view option_name);
 		/**
 		 * Access constant reference on option_schema with specified name
 		 * @param option_name
 		 * @return constant reference to stored option_schema
 		 * @throws not_found_exception if option_schema with given name does not exist
 		 */
-		const option_schema &operator[](const std::string &option_name) const;
+		const option_schema &operator[](std::string_view option_name) const;
 		/**
 		 * Tries to find option_schema with specified name inside this section.
 		 * @param option_name name which is searched
 		 * @return true if option_schema with this name is present, false otherwise
 		 */
-		bool contains(const std::string &option_name) const;
+		bool contains(std::string_view option_name) const;
+		/**
+		 * Find option_schema with specified name, no exception is thrown.
+		 * @param option_name name which is searched
+		 * @return pointer to stored option_schema or nullptr if there is no such option
+		 */
+		option_schema *find(std::string_view option_name);
+		/**
+		 * Find option_schema with specified name, no exception is thrown.
+		 * @param option_name name which is searched
+		 * @return pointer to stored option_schema or nullptr if there is no such option
+		 */
+		const option_schema *find(std::string_view option_name) const;
 
 		/**
 		 * Validate given section againts this section_schema.
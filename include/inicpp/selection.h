@@ -0,0 +1,90 @@
+#ifndef INICPP_SELECTION_H
+#define INICPP_SELECTION_H
+
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dll.h"
+#include "schema.h"
+
+namespace inicpp
+{
+	/**
+	 * Selection of sections and options which should be loaded. Parser skips
+	 * not selected sections at the lexer level, their lines are only checked
+	 * for start of the next section, so they are not validated, unescaped
+	 * or allocated. Not selected options are skipped before their values are split.
+	 * Links cannot point to skipped sections or options.
+	 * Default constructed selection selects everything.
+	 */
+	class INICPP_API selection
+	{
+	public:
+		/** Predicate which selects sections by their names */
+		using section_predicate = std::function<bool(std::string_view section_name)>;
+		/** Predicate which selects options by names of the section and the option */
+		using option_predicate = std::function<bool(std::string_view section_name, std::string_view option_name)>;
+
+	private:
+		/** Selected sections, nullptr selects all */
+		section_predicate sections_;
+		/** Selected options of selected sections, nullptr selects all */
+		option_predicate options_;
+
+	public:
+		/**
+		 * Construct selection of everything.
+		 */
+		selection();
+		/**
+		 * Construct selection of sections with given names and all their options.
+		 * @param section_names names of selected sections
+		 */
+		selection(std::initializer_list<std::string> section_names);
+		/**
+		 * Construct selection of sections with given names and all their options.
+		 * @param section_names names of selected sections
+		 */
+		explicit selection(const std::vector<std::string> &section_names);
+		/**
+		 * Construct selection of sections by given predicates.
+		 * @param sections predicate which selects sections
+		 * @param options predicate which selects options of selected sections, nullptr selects all
+		 */
+		explicit selection(section_predicate sections, option_predicate options = nullptr);
+		/**
+		 * Construct selection of sections and options which are described by given schema.
+		 * @param schm validation schema
+		 */
+		explicit selection(const schema &schm);
+
+		/**
+		 * Determines if whole input is selected.
+		 * @return true if no section or option is skipped
+		 */
+		bool selects_all() const;
+		/**
+		 * Determines if options of selected sections are filtered.
+		 * @return true if some options can be skipped
+		 */
+		bool filters_options() const;
+		/**
+		 * Determines if section with given name is selected.
+		 * @param section_name name of the section
+		 * @return true if section should be loaded
+		 */
+		bool contains_section(std::string_view section_name) const;
+		/**
+		 * Determines if option of selected section is selected.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @return true if option should be loaded
+		 */
+		bool contains_option(std::string_view section_name, std::string_view option_name) const;
+	};
+}
+
+#endif // INICPP_SELECTION_H
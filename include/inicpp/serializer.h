@@ -0,0 +1,177 @@
+#ifndef INICPP_SERIALIZER_H
+#define INICPP_SERIALIZER_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "config.h"
+#include "dll.h"
+#include "exception.h"
+#include "schema.h"
+
+namespace inicpp
+{
+	/**
+	 * Writes configs and schemas in ini format into an output buffer.
+	 * Values are formatted directly into the buffer without streams and temporary
+	 * lists, the buffer is emitted to its sink in one write when it is full.
+	 * Floats are written in the shortest text which is loaded back to the same value.
+	 * Serializer can write into a string (no intermediate buffer is used then),
+	 * an output stream or a file descriptor. Remaining data are written by flush()
+	 * or by the destructor, which ignores errors.
+	 */
+	class INICPP_API serializer
+	{
+	public:
+		/** Default size of the buffer in bytes */
+		static constexpr size_t default_capacity = 1 << 16;
+
+	private:
+		/** Output string, nullptr if other sink is used */
+		std::string *string_;
+		/** Output stream, nullptr if other sink is used */
+		std::ostream *stream_;
+		/** Output file descriptor, -1 if other sink is used */
+		int fd_;
+		/** Buffered data which were not emitted yet */
+		std::string buffer_;
+		/** Size of buffer which triggers emitting */
+		size_t capacity_;
+
+		/**
+		 * Buffer into which data are formatted.
+		 * @return output string or internal buffer
+		 */
+		std::string &output()
+		{
+			return (string_ != nullptr ? *string_ : buffer_);
+		}
+		/**
+		 * Emit the buffer if it is full.
+		 */
+		void check_capacity()
+		{
+			if (string_ == nullptr && buffer_.size() >= capacity_) {
+				flush();
+			}
+		}
+		/**
+		 * Append escaped string value, leading and trailing whitespaces are escaped.
+		 * @param value written value
+		 */
+		void write_escaped(std::string_view value);
+		/**
+		 * Append all values of the option separated by commas.
+		 * @param opt written option
+		 */
+		void write_values(const option &opt);
+		/**
+		 * Append lines of a comment.
+		 * @param comment comment which can have more lines
+		 */
+		void write_comment(const std::string &comment);
+
+	public:
+		/**
+		 * Construct serializer which appends to given string.
+		 * @param output string, it has to outlive the serializer
+		 */
+		explicit serializer(std::string &output);
+		/**
+		 * Construct serializer which writes to given stream.
+		 * @param output stream, it has to outlive the serializer
+		 * @param capacity size of the buffer
+		 */
+		explicit serializer(std::ostream &output, size_t capacity = default_capacity);
+		/**
+		 * Construct serializer which writes to given file descriptor.
+		 * @param fd open file descriptor, it is not closed by serializer
+		 * @param capacity size of the buffer
+		 */
+		explicit serializer(int fd, size_t capacity = default_capacity);
+		/**
+		 * Deleted copy constructor.
+		 */
+		serializer(const serializer &source) = delete;
+		/**
+		 * Deleted copy assignment.
+		 */
+		serializer &operator=(const serializer &source) = delete;
+		/**
+		 * Destructor, writes remaining data and ignores errors.
+		 */
+		~serializer();
+
+		/**
+		 * Write option line.
+		 * @param opt written option
+		 * @return reference to this
+		 */
+		serializer &write(const option &opt);
+		/**
+		 * Write section header and all its options.
+		 * @param sect written section
+		 * @return reference to this
+		 */
+		serializer &write(const section &sect);
+		/**
+		 * Write all sections of the config.
+		 * @param cfg written config
+		 * @return reference to this
+		 */
+		serializer &write(const config &cfg);
+		/**
+		 * Write comments of option_schema and option line with its default value.
+		 * @param opt_schema written option_schema
+		 * @return reference to this
+		 */
+		serializer &write(const option_schema &opt_schema);
+		/**
+		 * Write comments of section_schema, section header and all its option_schemas.
+		 * @param sect_schema written section_schema
+		 * @return reference to this
+		 */
+		serializer &write(const section_schema &sect_schema);
+		/**
+		 * Write all section_schemas of the schema.
+		 * @param schm written schema
+		 * @return reference to this
+		 */
+		serializer &write(const schema &schm);
+		/**
+		 * Write config with comments from schema, options missing
+		 * in config are written with their default values.
+		 * @param cfg written config
+		 * @param schm schema of the config
+		 * @return reference to this
+		 */
+		serializer &write(const config &cfg, const schema &schm);
+		/**
+		 * Write comment lines with additional information about option.
+		 * @param opt_schema described option
+		 * @return reference to this
+		 */
+		serializer &write_info(const option_schema &opt_schema);
+		/**
+		 * Write comment lines with additional information about section.
+		 * @param sect_schema described section
+		 * @return reference to this
+		 */
+		serializer &write_info(const section_schema &sect_schema);
+		/**
+		 * Write section header.
+		 * @param name name of the section
+		 * @return reference to this
+		 */
+		serializer &write_section_name(std::string_view name);
+
+		/**
+		 * Emit buffered data to the sink.
+		 * @throws parser_exception if data cannot be written
+		 */
+		void flush();
+	};
+}
+
+#endif // INICPP_SERIALIZER_H
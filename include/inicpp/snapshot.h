@@ -0,0 +1,371 @@
+#ifndef INICPP_SNAPSHOT_H
+#define INICPP_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "config.h"
+#include "dll.h"
+#include "exception.h"
+#include "types.h"
+
+namespace inicpp
+{
+	/** Forward declaration of internal file mapping */
+	class mapped_file;
+
+
+	/**
+	 * Compact binary image of a config which can be opened without parsing.
+	 * Snapshot is written from a (usually validated) config and contains a header
+	 * with magic, format version, byte order marker and checksum, followed by
+	 * table of sections, table of options, array of typed values and string table.
+	 * Sections and options of each section have additional index sorted by name,
+	 * so lookups are binary searches served directly from the mapped file.
+	 * Values are stored in their types, strings and enums are returned as views
+	 * into the snapshot. Snapshot can be read only on platform with the same byte order.
+	 */
+	class INICPP_API snapshot
+	{
+	private:
+		/**
+		 * Header on the beginning of snapshot file.
+		 */
+		struct header {
+			/** Magic bytes identifying snapshot */
+			char magic[8];
+			/** Version of format */
+			uint32_t version;
+			/** Byte order marker, written as native integer */
+			uint32_t byte_order;
+			/** Size of whole snapshot in bytes */
+			uint64_t file_size;
+			/** Checksum of everything after this header */
+			uint64_t checksum;
+			/** Number of sections */
+			uint64_t section_count;
+			/** Number of options of all sections */
+			uint64_t option_count;
+			/** Number of values of all options */
+			uint64_t value_count;
+			/** Size of string table in bytes */
+			uint64_t strings_size;
+			/** Offset of section table */
+			uint64_t sections_offset;
+			/** Offset of section indexes sorted by section names */
+			uint64_t section_order_offset;
+			/** Offset of option table */
+			uint64_t options_offset;
+			/** Offset of option indexes sorted by option names within each section */
+			uint64_t option_order_offset;
+			/** Offset of value array */
+			uint64_t values_offset;
+			/** Offset of string table */
+			uint64_t strings_offset;
+		};
+
+		/**
+		 * Record of one section in section table.
+		 */
+		struct section_record {
+			/** Offset of the name in string table */
+			uint32_t name_offset;
+			/** Length of the name */
+			uint32_t name_length;
+			/** Index of the first option of this section in option table */
+			uint32_t first_option;
+			/** Number of options of this section */
+			uint32_t option_count;
+		};
+
+		/**
+		 * Record of one option in option table.
+		 */
+		struct option_record {
+			/** Offset of the name in string table */
+			uint32_t name_offset;
+			/** Length of the name */
+			uint32_t name_length;
+			/** Index of the first value of this option in value array */
+			uint32_t first_value;
+			/** Number of values of this option */
+			uint32_t value_count;
+			/** Type of values, option_type stored as integer */
+			uint32_t type;
+			/** Unused, keeps records aligned */
+			uint32_t reserved;
+		};
+
+		/** Input owned by this instance if it is not mapped */
+		std::string buffer_;
+		/** Mapping of snapshot file */
+		std::shared_ptr<mapped_file> mapping_;
+		/** Copy of snapshot header */
+		header header_;
+
+		/**
+		 * Construct empty instance, it is filled by open() or load().
+		 */
+		snapshot();
+
+		/**
+		 * Whole snapshot data.
+		 * @return view to owned buffer or file mapping
+		 */
+		std::string_view data() const;
+		/**
+		 * Check header of the snapshot and optionally its checksum.
+		 * @param verify_checksum true if checksum of the whole snapshot should be checked
+		 * @throws parser_exception if snapshot is malformed
+		 */
+		void check(bool verify_checksum);
+		/**
+		 * Read one record from the snapshot.
+		 * @param offset offset of the table
+		 * @param index index of the record in the table
+		 * @return copy of the record
+		 */
+		template <typename Record> Record read(uint64_t offset, size_t index) const
+		{
+			Record record;
+			std::memcpy(&record, data().data() + offset + index * sizeof(Record), sizeof(Record));
+			return record;
+		}
+		/**
+		 * Get string from string table.
+		 * @param offset offset of the string in string table
+		 * @param length length of the string
+		 * @return view into the snapshot
+		 * @throws parser_exception if string is out of string table
+		 */
+		std::string_view string_at(uint32_t offset, uint32_t length) const;
+		/**
+		 * Find index of section with given name.
+		 * @param section_name name of the section
+		 * @return index of section or npos if there is no such section
+		 */
+		size_t find_section(std::string_view section_name) const;
+		/**
+		 * Find index of option record with given name.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @return index of option record or npos if there is no such section or option
+		 */
+		size_t find_option(std::string_view section_name, std::string_view option_name) const;
+		/**
+		 * Get option record with given name.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @return record of the option
+		 * @throws not_found_exception if there is no such section or option
+		 */
+		option_record get_option(std::string_view section_name, std::string_view option_name) const;
+		/**
+		 * Get raw value of an option.
+		 * @param record record of the option
+		 * @param index index of the value
+		 * @return bits of stored value
+		 * @throws not_found_exception if index is out of range
+		 */
+		uint64_t raw_value(const option_record &record, size_t index) const;
+		/**
+		 * Get string value of an option.
+		 * @param record record of the option, it has to be string or enum
+		 * @param index index of the value
+		 * @return view into the snapshot
+		 * @throws not_found_exception if index is out of range
+		 */
+		std::string_view string_value(const option_record &record, size_t index) const;
+		/**
+		 * Get one value of the option in requested type.
+		 * @param record record of the option
+		 * @param index index of the value
+		 * @return converted value
+		 * @throws bad_cast_exception if option is not stored in requested type
+		 */
+		template <typename ReturnType> ReturnType get_value(const option_record &record, size_t index) const
+		{
+			option_type type = static_cast<option_type>(record.type);
+			if constexpr (std::is_same<ReturnType, string_ini_t>::value ||
+				std::is_same<ReturnType, enum_ini_t>::value) {
+				if (type != option_type::string_e && type != option_type::enum_e) {
+					throw bad_cast_exception("Cannot cast to requested type");
+				}
+				return ReturnType(std::string(string_value(record, index)));
+			} else {
+				if (type != get_option_enum_type<ReturnType>()) {
+					throw bad_cast_exception("Cannot cast to requested type");
+				}
+				uint64_t bits = raw_value(record, index);
+				if constexpr (std::is_same<ReturnType, boolean_ini_t>::value) {
+					return bits != 0;
+				} else {
+					ReturnType value;
+					std::memcpy(&value, &bits, sizeof(value));
+					return value;
+				}
+			}
+		}
+		/**
+		 * Get all values of the option in requested type.
+		 * @param record record of the option
+		 * @return new list of all stored values
+		 * @throws bad_cast_exception if option is not stored in requested type
+		 */
+		template <typename ReturnType> std::vector<ReturnType> read_values(const option_record &record) const
+		{
+			std::vector<ReturnType> results;
+			results.reserve(record.value_count);
+			for (size_t i = 0; i < record.value_count; ++i) {
+				results.push_back(get_value<ReturnType>(record, i));
+			}
+			return results;
+		}
+
+	public:
+		/**
+		 * Deleted copy constructor.
+		 */
+		snapshot(const snapshot &source) = delete;
+		/**
+		 * Deleted copy assignment.
+		 */
+		snapshot &operator=(const snapshot &source) = delete;
+		/**
+		 * Move constructor.
+		 */
+		snapshot(snapshot &&source) noexcept;
+		/**
+		 * Move assignment.
+		 */
+		snapshot &operator=(snapshot &&source) noexcept;
+		/**
+		 * Destructor.
+		 */
+		~snapshot();
+
+		/**
+		 * Write snapshot of given config. Options keep types they have in the config,
+		 * so config should be validated against schema before writing.
+		 * @param cfg written config
+		 * @param output stream to which snapshot is written, should be opened in binary mode
+		 * @throws parser_exception if config is too large for snapshot format
+		 */
+		static void write(const config &cfg, std::ostream &output);
+		/**
+		 * Write snapshot of given config into file.
+		 * @param cfg written config
+		 * @param file name of the created file
+		 * @throws parser_exception if file cannot be written or config is too large
+		 */
+		static void write_file(const config &cfg, const std::string &file);
+		/**
+		 * Open snapshot from memory, data are moved into the instance.
+		 * Only the header and bounds of tables are checked by default,
+		 * see open() for the trade-off.
+		 * @param data snapshot data
+		 * @param verify_checksum true if checksum of the whole snapshot should be verified
+		 * @return opened snapshot
+		 * @throws parser_exception if snapshot is malformed
+		 */
+		static snapshot load(std::string data, bool verify_checksum = false);
+		/**
+		 * Open snapshot file. File is mapped to memory and only its header is read,
+		 * so opening takes constant time and pages are loaded only when they are looked up.
+		 * Verification of checksum reads the whole file, so it is off by default.
+		 * Every read is still bounds checked, so damaged content gives wrong values or
+		 * parser_exception, but never reads outside of the snapshot. Pass true when
+		 * the file comes from untrusted storage or opening time does not matter.
+		 * @param file name of the snapshot file
+		 * @param verify_checksum true if checksum of the whole snapshot should be verified
+		 * @return opened snapshot
+		 * @throws parser_exception if file cannot be read or snapshot is malformed
+		 */
+		static snapshot open(const std::string &file, bool verify_checksum = false);
+
+		/**
+		 * Returns number of sections.
+		 * @return unsigned integer
+		 */
+		size_t size() const;
+		/**
+		 * Name of section on given index, sections are in order of the config.
+		 * @param index index of the section
+		 * @return view into the snapshot
+		 * @throws not_found_exception if index is out of range
+		 */
+		std::string_view section_name(size_t index) const;
+		/**
+		 * Tries to find section with specified name.
+		 * @param section_name name which is searched
+		 * @return true if section with this name is present, false otherwise
+		 */
+		bool contains(std::string_view section_name) const;
+		/**
+		 * Tries to find option with specified name in given section.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @return true if option is present, false otherwise
+		 */
+		bool contains(std::string_view section_name, std::string_view option_name) const;
+		/**
+		 * Type of stored option.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @return type of values of the option
+		 * @throws not_found_exception if there is no such section or option
+		 */
+		option_type get_type(std::string_view section_name, std::string_view option_name) const;
+		/**
+		 * Get single element value, first element if option is a list.
+		 * Values can be read only in their stored type, strings and enums
+		 * can be read as string_ini_t too.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @return copy of the value
+		 * @throws not_found_exception if there is no such option or it has no value
+		 * @throws bad_cast_exception if option is not stored in requested type
+		 */
+		template <typename ReturnType>
+		ReturnType get(std::string_view section_name, std::string_view option_name) const
+		{
+			return get_value<ReturnType>(get_option(section_name, option_name), 0);
+		}
+		/**
+		 * Get list of values of the option.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @return new list of all stored values
+		 * @throws not_found_exception if there is no such option
+		 * @throws bad_cast_exception if option is not stored in requested type
+		 */
+		template <typename ReturnType>
+		std::vector<ReturnType> get_list(std::string_view section_name, std::string_view option_name) const
+		{
+			return read_values<ReturnType>(get_option(section_name, option_name));
+		}
+		/**
+		 * Get string or enum value without copying it.
+		 * @param section_name name of the section
+		 * @param option_name name of the option
+		 * @param index index of the value in the list
+		 * @return view into the snapshot, valid while the snapshot exists
+		 * @throws not_found_exception if there is no such option or value
+		 * @throws bad_cast_exception if option is not string or enum
+		 */
+		std::string_view get_view(std::string_view section_name, std::string_view option_name, size_t index = 0) const;
+
+		/**
+		 * Create config with the same contents as this snapshot.
+		 * @return new config instance
+		 */
+		config to_config() const;
+	};
+}
+
+#endif // INICPP_SNAPSHOT_H
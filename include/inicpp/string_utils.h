@@ -7,6 +7,7 @@
 #include <cctype>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace inicpp
@@ -35,6 +36,24 @@ namespace inicpp
 		 * @return newly created instance of string
 		 */
 		std::string trim(const std::string &str);
+		/**
+		 * Trim whitespaces from start of given string without copying it.
+		 * @param str processed string
+		 * @return view to the trimmed part of @a str
+		 */
+		std::string_view left_trim_view(std::string_view str);
+		/**
+		 * Trim whitespaces from end of given string without copying it.
+		 * @param str processed string
+		 * @return view to the trimmed part of @a str
+		 */
+		std::string_view right_trim_view(std::string_view str);
+		/**
+		 * Trim whitespaces from start and end of given string without copying it.
+		 * @param str processed string
+		 * @return view to the trimmed part of @a str
+		 */
+		std::string_view trim_view(std::string_view str);
 		/**
 		 * In @a haystack find any occurence of needle.
 		 * @param haystack string in which search is executed
@@ -65,6 +84,73 @@ namespace inicpp
 		std::vector<std::string> split(const std::string &str, char delim);
 
 
+		/**
+		 * Result of parse_value() functions.
+		 */
+		enum class parse_status { ok, invalid, out_of_range };
+
+		/**
+		 * Parse boolean keyword. Recognized are 1, t, y, on, yes, enabled
+		 * and 0, f, n, off, no, disabled.
+		 * @param str parsed text, it has to be consumed whole
+		 * @param value parsed value, unchanged if parsing fails
+		 * @return ok or invalid
+		 */
+		parse_status parse_value(std::string_view str, boolean_ini_t &value);
+		/**
+		 * Parse signed integer with optional sign. Base is given by prefix,
+		 * 0x for hexadecimal, 0b for binary, 0 for octal, decimal otherwise.
+		 * Parsing does not depend on locale, allocate or throw.
+		 * @param str parsed text, it has to be consumed whole
+		 * @param value parsed value, unchanged if parsing fails
+		 * @return ok, invalid or out_of_range
+		 */
+		parse_status parse_value(std::string_view str, signed_ini_t &value);
+		/**
+		 * Parse unsigned integer, prefixes are the same as for signed integers.
+		 * @param str parsed text, it has to be consumed whole
+		 * @param value parsed value, unchanged if parsing fails
+		 * @return ok, invalid or out_of_range
+		 */
+		parse_status parse_value(std::string_view str, unsigned_ini_t &value);
+		/**
+		 * Parse floating point number with optional sign, in decimal
+		 * or 0x prefixed hexadecimal notation, inf and nan are accepted too.
+		 * Result is correctly rounded and does not depend on locale.
+		 * @param str parsed text, it has to be consumed whole
+		 * @param value parsed value, unchanged if parsing fails
+		 * @return ok, invalid or out_of_range
+		 */
+		parse_status parse_value(std::string_view str, float_ini_t &value);
+
+		/** Size of buffer which fits text of any value written by format_value() */
+		const size_t max_formatted_length = 32;
+
+		/**
+		 * Write signed integer in decimal notation.
+		 * Formatting does not depend on locale, allocate or throw.
+		 * @param value formatted value
+		 * @param buffer output of at least max_formatted_length characters, it is not null terminated
+		 * @return number of written characters
+		 */
+		size_t format_value(signed_ini_t value, char *buffer);
+		/**
+		 * Write unsigned integer in decimal notation.
+		 * @param value formatted value
+		 * @param buffer output of at least max_formatted_length characters, it is not null terminated
+		 * @return number of written characters
+		 */
+		size_t format_value(unsigned_ini_t value, char *buffer);
+		/**
+		 * Write the shortest text which is parsed back to exactly the same floating
+		 * point number. Fixed or exponential notation is chosen by which one is shorter,
+		 * infinities and NaN are written as inf and nan.
+		 * @param value formatted value
+		 * @param buffer output of at least max_formatted_length characters, it is not null terminated
+		 * @return number of written characters
+		 */
+		size_t format_value(float_ini_t value, char *buffer);
+
 		/**
 		 * Function for parsing string input value to strongly typed one
 		 * @param value Value to be parsed
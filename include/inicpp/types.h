@@ -73,17 +73,17 @@ namespace inicpp
 			throw std::runtime_error("Enum type cannot be converted to double");
 		}
 		/** Equality operator */
-		bool operator==(const internal_enum_type &other)
+		bool operator==(const internal_enum_type &other) const
 		{
 			return data_ == other.data_;
 		}
 		/** Inequality operator */
-		bool operator!=(const internal_enum_type &other)
+		bool operator!=(const internal_enum_type &other) const
 		{
 			return !(*this == other);
 		}
 		/** Comparation less operator */
-		bool operator<(const internal_enum_type &other)
+		bool operator<(const internal_enum_type &other) const
 		{
 			return data_ < other.data_;
 		}
@@ -128,6 +128,13 @@ namespace inicpp
 	 */
 	enum class schema_mode : bool { strict, relaxed };
 
+	/**
+	 * Index used by config and section for lookups by name.
+	 *  Ordered - balanced tree of names, default.
+	 *  Hashed - flat hash table, faster and smaller for large sections.
+	 */
+	enum class index_policy : bool { ordered, hashed };
+
 	/**
 	 * Function for convert type (one of *_ini_t) to option_type
 	 * enumeration type. If type cannot be converted, invalid_e
@@ -8,7 +8,7 @@ URL: https://github.com/SemaiCZE/%{name}
 Source0: https://github.com/SemaiCZE/%{name}/archive/v%{version}.tar.gz#/%{name}-%{version}.tar.gz
 
 %description
-Modern, C++14 library for parsing INI files with schema validation.
+Modern, C++17 library for parsing INI files with schema validation.
 
 %prep
 %autosetup
@@ -32,7 +32,7 @@ Summary: Header and static library for %{name}.
 Recommends: %{name}
 
 %description devel
-%{name} is a modern, C++14 library for parsing INI files with schema validation.  This %{name}-devel package contains the headers and optional static library for compiling against the library.
+%{name} is a modern, C++17 library for parsing INI files with schema validation.  This %{name}-devel package contains the headers and optional static library for compiling against the library.
 
 %files devel
 %{_libdir}/libinicpp_static.a
@@ -0,0 +1,293 @@
+#include "compiled_schema.h"
+#include "config.h"
+#include "schema.h"
+
+namespace inicpp
+{
+	namespace
+	{
+		/** Number of seeds tried before the hash table is enlarged */
+		const size_t seed_attempts = 32;
+
+		/**
+		 * Hash name with given seed. FNV-1a is used for the bytes, final mixing
+		 * spreads the differences to low bits which are used as slot index.
+		 * @param name hashed name
+		 * @param seed seed of the table
+		 * @return hash of the name
+		 */
+		uint64_t hash_name(std::string_view name, uint64_t seed)
+		{
+			uint64_t hash = 14695981039346656037ull ^ seed;
+			for (char ch : name) {
+				hash ^= static_cast<unsigned char>(ch);
+				hash *= 1099511628211ull;
+			}
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdull;
+			hash ^= hash >> 33;
+			return hash;
+		}
+	}
+
+	compiled_schema::compiled_schema(const schema &schm) : schema_(std::make_shared<const schema>(schm))
+	{
+		std::vector<std::string_view> section_names;
+		for (size_t i = 0; i < schema_->size(); ++i) {
+			const section_schema &sect_schema = (*schema_)[i];
+			section_names.push_back(sect_schema.get_name());
+
+			std::vector<std::string_view> option_names;
+			section_plan sect_plan;
+			sect_plan.schema = &sect_schema;
+			sect_plan.first_option = options_.size();
+			sect_plan.option_count = sect_schema.size();
+			for (size_t j = 0; j < sect_schema.size(); ++j) {
+				const option_schema &opt_schema = sect_schema[j];
+				option_names.push_back(opt_schema.get_name());
+
+				// typed parameters are resolved now, so validation does not need any casts
+				option_plan opt_plan;
+				opt_plan.schema = &opt_schema;
+				opt_plan.params = opt_schema.params_.get();
+				opt_plan.validate_items = nullptr;
+				switch (opt_schema.get_type()) {
+				case option_type::boolean_e:
+					if (dynamic_cast<const option_schema_params<boolean_ini_t> &>(*opt_plan.params).validator) {
+						opt_plan.validate_items = &validate_typed_items<boolean_ini_t>;
+					}
+					break;
+				case option_type::enum_e:
+					if (dynamic_cast<const option_schema_params<enum_ini_t> &>(*opt_plan.params).validator) {
+						opt_plan.validate_items = &validate_typed_items<enum_ini_t>;
+					}
+					break;
+				case option_type::float_e:
+					if (dynamic_cast<const option_schema_params<float_ini_t> &>(*opt_plan.params).validator) {
+						opt_plan.validate_items = &validate_typed_items<float_ini_t>;
+					}
+					break;
+				case option_type::signed_e:
+					if (dynamic_cast<const option_schema_params<signed_ini_t> &>(*opt_plan.params).validator) {
+						opt_plan.validate_items = &validate_typed_items<signed_ini_t>;
+					}
+					break;
+				case option_type::string_e:
+					if (dynamic_cast<const option_schema_params<string_ini_t> &>(*opt_plan.params).validator) {
+						opt_plan.validate_items = &validate_typed_items<string_ini_t>;
+					}
+					break;
+				case option_type::unsigned_e:
+					if (dynamic_cast<const option_schema_params<unsigned_ini_t> &>(*opt_plan.params).validator) {
+						opt_plan.validate_items = &validate_typed_items<unsigned_ini_t>;
+					}
+					break;
+				case option_type::invalid_e:
+					// never reached
+					throw invalid_type_exception("Invalid option type");
+					break;
+				}
+				options_.push_back(opt_plan);
+			}
+			sect_plan.options = build_table(option_names);
+			sections_.push_back(sect_plan);
+		}
+		section_names_ = build_table(section_names);
+	}
+
+	compiled_schema::compiled_schema(const compiled_schema &source) = default;
+
+	compiled_schema &compiled_schema::operator=(const compiled_schema &source) = default;
+
+	compiled_schema::compiled_schema(compiled_schema &&source) noexcept = default;
+
+	compiled_schema &compiled_schema::operator=(compiled_schema &&source) noexcept = default;
+
+	compiled_schema::~compiled_schema() = default;
+
+	compiled_schema::name_table compiled_schema::build_table(const std::vector<std::string_view> &names)
+	{
+		// table is at most half full, so a seed without collisions is found quickly
+		size_t size = 1;
+		while (size < names.size() * 2) {
+			size *= 2;
+		}
+
+		std::vector<uint32_t> slots;
+		for (;; size *= 2) {
+			for (uint64_t seed = 0; seed < seed_attempts; ++seed) {
+				slots.assign(size, 0);
+				bool collision = false;
+				for (size_t i = 0; i < names.size() && !collision; ++i) {
+					uint32_t &slot = slots[hash_name(names[i], seed) & (size - 1)];
+					collision = (slot != 0);
+					slot = static_cast<uint32_t>(i + 1);
+				}
+				if (!collision) {
+					name_table table;
+					table.seed = seed;
+					table.offset = slots_.size();
+					table.mask = size - 1;
+					slots_.insert(slots_.end(), slots.begin(), slots.end());
+					return table;
+				}
+			}
+		}
+	}
+
+	template <typename Names>
+	size_t compiled_schema::lookup(const name_table &table, std::string_view name, Names names) const
+	{
+		uint32_t slot = slots_[table.offset + (hash_name(name, table.seed) & table.mask)];
+		// every slot holds at most one name, so one comparison decides
+		if (slot == 0 || names(slot - 1) != name) {
+			return npos;
+		}
+		return slot - 1;
+	}
+
+	size_t compiled_schema::find_section(std::string_view section_name) const
+	{
+		return lookup(section_names_, section_name, [this](size_t index) -> const std::string & {
+			return sections_[index].schema->get_name();
+		});
+	}
+
+	size_t compiled_schema::find_option(const section_plan &sect_plan, std::string_view option_name) const
+	{
+		const option_plan *plans = options_.data() + sect_plan.first_option;
+		return lookup(sect_plan.options, option_name, [plans](size_t index) -> const std::string & {
+			return plans[index].schema->get_name();
+		});
+	}
+
+	const schema &compiled_schema::get_schema() const
+	{
+		return *schema_;
+	}
+
+	void compiled_schema::validate(config &cfg, schema_mode mode) const
+	{
+		// reads go through constant reference, so they do not mark sections as given out
+		const config &const_cfg = cfg;
+
+		// every section of the config is looked up only once
+		std::vector<size_t> found_sections(sections_.size(), npos);
+		size_t unknown = npos;
+		for (size_t i = 0; i < cfg.size(); ++i) {
+			size_t index = find_section(const_cfg[i].get_name());
+			if (index != npos) {
+				found_sections[index] = i;
+			} else if (unknown == npos) {
+				unknown = i;
+			}
+		}
+
+		// sections are processed in schema order, so errors are the same as of schema::validate_config()
+		std::vector<size_t> found_options;
+		for (size_t i = 0; i < sections_.size(); ++i) {
+			const section_plan &sect_plan = sections_[i];
+			const section_schema &sect_schema = *sect_plan.schema;
+			if (found_sections[i] != npos) {
+				validate_section(sect_plan, cfg, found_sections[i], mode, found_options);
+			} else if (sect_schema.is_mandatory()) {
+				throw validation_exception("Mandatory section '" + sect_schema.get_name() + "' is missing in config");
+			} else {
+				// missing optional section is added with default values of its options
+				cfg.add_section(sect_schema.get_name());
+				section &added = cfg.unshared_section(cfg.size() - 1);
+				for (size_t j = 0; j < sect_plan.option_count; ++j) {
+					auto &opt_schema = *options_[sect_plan.first_option + j].schema;
+					added.add_option(option(opt_schema.get_name(), opt_schema.get_default_value()));
+				}
+			}
+		}
+
+		if (unknown != npos && mode == schema_mode::strict) {
+			throw validation_exception("Section '" + const_cfg[unknown].get_name() + "' not specified in schema");
+		}
+	}
+
+	void compiled_schema::validate_section(const section_plan &sect_plan,
+		config &cfg,
+		size_t sect_position,
+		schema_mode mode,
+		std::vector<size_t> &found) const
+	{
+		const config &const_cfg = cfg;
+		found.assign(sect_plan.option_count, npos);
+		size_t unknown = npos;
+		const section &sect = const_cfg[sect_position];
+		for (size_t i = 0; i < sect.size(); ++i) {
+			size_t index = find_option(sect_plan, sect[i].get_name());
+			if (index != npos) {
+				found[index] = i;
+			} else if (unknown == npos) {
+				unknown = i;
+			}
+		}
+
+		// section can be cloned by validation of its options, so it is not referenced below
+		for (size_t i = 0; i < sect_plan.option_count; ++i) {
+			const option_plan &opt_plan = options_[sect_plan.first_option + i];
+			const option_schema &opt_schema = *opt_plan.schema;
+			if (found[i] != npos) {
+				validate_option(opt_plan, cfg, sect_position, found[i]);
+			} else if (opt_schema.is_mandatory()) {
+				throw validation_exception("Mandatory option '" + opt_schema.get_name() + "' is missing in section '" +
+					const_cfg[sect_position].get_name() + "'");
+			} else {
+				// missing optional option is added with its default value parsed to proper type
+				section &modified = cfg.unshared_section(sect_position);
+				modified.add_option(option(opt_schema.get_name(), opt_schema.get_default_value()));
+				validate_option(opt_plan, cfg, sect_position, modified.size() - 1);
+			}
+		}
+
+		if (unknown != npos && mode == schema_mode::strict) {
+			throw validation_exception(
+				"Option '" + const_cfg[sect_position][unknown].get_name() + "' not specified in schema");
+		}
+	}
+
+	void compiled_schema::validate_option(
+		const option_plan &opt_plan, config &cfg, size_t sect_position, size_t opt_position) const
+	{
+		const config &const_cfg = cfg;
+		const option_schema &opt_schema = *opt_plan.schema;
+		const option &opt = const_cfg[sect_position][opt_position];
+		if (!opt_schema.is_list() && opt.is_list()) {
+			throw validation_exception("Option '" + opt.get_name() + "' - list given, single value expected");
+		} else if (opt_schema.is_list() && !opt.is_list()) {
+			throw validation_exception("Option '" + opt.get_name() + "' - single value given, list expected");
+		}
+
+		if (opt.get_type() != opt_schema.get_type()) {
+			// only options parsed to other type are modified, so only they are cloned if they are shared
+			opt_schema.parse_option_items(cfg.unshared_section(sect_position).unshared_option(opt_position));
+		}
+		if (opt_plan.validate_items != nullptr) {
+			opt_plan.validate_items(*opt_plan.params, const_cfg[sect_position][opt_position]);
+		}
+	}
+
+	template <typename ValueType>
+	void compiled_schema::validate_typed_items(const option_schema_params_base &params, const option &opt)
+	{
+		auto &validator = static_cast<const option_schema_params<ValueType> &>(params).validator;
+		auto check = [&validator, &opt](const auto &values) {
+			for (const auto &item : values) {
+				if (!validator(item)) {
+					throw validation_exception("Option '" + opt.get_name() + "' - validation failed");
+				}
+			}
+		};
+
+		// values are validated in place when they are stored in the type of the validator
+		if (auto values = opt.typed_values<ValueType>()) {
+			check(*values);
+		} else {
+			check(opt.get_list<ValueType>());
+		}
+	}
+}
@@ -1,4 +1,8 @@
 #include "config.h"
+#include "compiled_schema.h"
+#include "serializer.h"
+
+#include <atomic>
 
 namespace inicpp
 {
@@ -6,17 +10,20 @@ namespace inicpp
 	{
 	}
 
-	config::config(const config &source)
+	config::config(index_policy policy) : index_(policy)
 	{
-		// we have to do deep copies of sections
-		sections_.reserve(source.sections_.size());
-		for (auto &sect : source.sections_) {
-			sections_.push_back(std::make_shared<section>(*sect));
-		}
+	}
 
-		// we already have constructed sections... now push them into map
-		for (auto &sect : sections_) {
-			sections_map_.insert(sections_map_pair(sect->get_name(), sect));
+	config::config(const config &source) : index_(source.index_), exposed_(source.exposed_.size(), false)
+	{
+		sections_.reserve(source.sections_.size());
+		for (size_t i = 0; i < source.sections_.size(); ++i) {
+			// references to exposed section can modify it, so the copy gets its own clone
+			if (source.exposed_[i]) {
+				sections_.push_back(std::make_shared<section>(*source.sections_[i]));
+			} else {
+				sections_.push_back(source.sections_[i]);
+			}
 		}
 	}
 
@@ -31,27 +38,63 @@ namespace inicpp
 		return *this;
 	}
 
-	config::config(config &&source)
+	config::config(config &&source) noexcept
+		: sections_(std::move(source.sections_)), index_(std::move(source.index_)), exposed_(std::move(source.exposed_))
 	{
-		operator=(std::move(source));
 	}
 
-	config &config::operator=(config &&source)
+	config &config::operator=(config &&source) noexcept
 	{
 		if (this != &source) {
 			sections_ = std::move(source.sections_);
-			sections_map_ = std::move(source.sections_map_);
+			index_ = std::move(source.index_);
+			exposed_ = std::move(source.exposed_);
 		}
 		return *this;
 	}
 
+	section &config::unshared_section(size_t position)
+	{
+		std::shared_ptr<section> &sect = sections_[position];
+		// only owners can create new owners, so a section owned just by this config stays ours
+		// as copying of this config cannot run concurrently with modification
+		if (sect.use_count() > 1) {
+			sect = std::make_shared<section>(*sect);
+		} else {
+			// use count is loaded relaxed, fence orders reads of released copies before our writes
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		return *sect;
+	}
+
+	section &config::unshared_section(std::string_view section_name)
+	{
+		size_t position = index_.find(section_name, sections_);
+		if (position == index_.npos) {
+			throw not_found_exception(std::string(section_name));
+		}
+		return unshared_section(position);
+	}
+
 	void config::add_section(const section &sect)
 	{
-		auto add_it = sections_map_.find(sect.get_name());
-		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section> add = std::make_shared<section>(sect);
-			sections_.push_back(add);
-			sections_map_.insert(sections_map_pair(add->get_name(), add));
+		if (!contains(sect.get_name())) {
+			sections_.push_back(std::make_shared<section>(sect));
+			index_.push_back(sections_);
+			exposed_.push_back(false);
+		} else {
+			throw ambiguity_exception(sect.get_name());
+		}
+	}
+
+	void config::add_section(section &&sect)
+	{
+		if (!contains(sect.get_name())) {
+			// references to options of moved section can still be used, so it cannot be shared then
+			bool exposed = sect.has_exposed_options();
+			sections_.push_back(std::make_shared<section>(std::move(sect)));
+			index_.push_back(sections_);
+			exposed_.push_back(exposed);
 		} else {
 			throw ambiguity_exception(sect.get_name());
 		}
@@ -59,11 +102,10 @@ namespace inicpp
 
 	void config::add_section(const std::string &section_name)
 	{
-		auto add_it = sections_map_.find(section_name);
-		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section> add = std::make_shared<section>(section_name);
-			sections_.push_back(add);
-			sections_map_.insert(sections_map_pair(add->get_name(), add));
+		if (!contains(section_name)) {
+			sections_.push_back(std::make_shared<section>(section_name, index_.get_policy()));
+			index_.push_back(sections_);
+			exposed_.push_back(false);
 		} else {
 			throw ambiguity_exception(section_name);
 		}
@@ -71,16 +113,11 @@ namespace inicpp
 
 	void config::remove_section(const std::string &section_name)
 	{
-		auto del_it = sections_map_.find(section_name);
-		if (del_it != sections_map_.end()) {
-			// remove from map
-			sections_map_.erase(del_it);
-			// remove from vector
-			sections_.erase(
-				std::remove_if(sections_.begin(),
-					sections_.end(),
-					[&](std::shared_ptr<section> sect) { return (sect->get_name() == section_name ? true : false); }),
-				sections_.end());
+		size_t position = index_.find(section_name, sections_);
+		if (position != index_.npos) {
+			sections_.erase(sections_.begin() + position);
+			exposed_.erase(exposed_.begin() + position);
+			index_.erase(section_name, position, sections_);
 		} else {
 			throw not_found_exception(section_name);
 		}
@@ -88,22 +125,17 @@ namespace inicpp
 
 	void config::add_option(const std::string &section_name, const option &opt)
 	{
-		auto sect_it = sections_map_.find(section_name);
-		if (sect_it != sections_map_.end()) {
-			sect_it->second->add_option(opt);
-		} else {
-			throw not_found_exception(section_name);
-		}
+		unshared_section(section_name).add_option(opt);
+	}
+
+	void config::add_option(const std::string &section_name, option &&opt)
+	{
+		unshared_section(section_name).add_option(std::move(opt));
 	}
 
 	void config::remove_option(const std::string &section_name, const std::string &option_name)
 	{
-		auto sect_it = sections_map_.find(section_name);
-		if (sect_it != sections_map_.end()) {
-			sect_it->second->remove_option(option_name);
-		} else {
-			throw not_found_exception(section_name);
-		}
+		unshared_section(section_name).remove_option(option_name);
 	}
 
 	size_t config::size() const
@@ -113,11 +145,7 @@ namespace inicpp
 
 	section &config::operator[](size_t index)
 	{
-		if (index >= sections_.size()) {
-			throw not_found_exception(index);
-		}
-
-		return *sections_[index];
+		return mutable_section(index);
 	}
 
 	const section &config::operator[](size_t index) const
@@ -129,36 +157,55 @@ namespace inicpp
 		return *sections_[index];
 	}
 
-	section &config::operator[](const std::string &section_name)
+	section &config::operator[](std::string_view section_name)
 	{
-		std::shared_ptr<section> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(section_name);
+		return mutable_section(section_name);
+	}
+
+	const section &config::operator[](std::string_view section_name) const
+	{
+		auto result = find(section_name);
+		if (result == nullptr) {
+			throw not_found_exception(std::string(section_name));
 		}
 		return *result;
 	}
 
-	const section &config::operator[](const std::string &section_name) const
+	bool config::contains(std::string_view section_name) const
 	{
-		std::shared_ptr<section> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(section_name);
+		return find(section_name) != nullptr;
+	}
+
+	section *config::find(std::string_view section_name)
+	{
+		size_t position = index_.find(section_name, sections_);
+		return (position == index_.npos ? nullptr : &mutable_section(position));
+	}
+
+	const section *config::find(std::string_view section_name) const
+	{
+		size_t position = index_.find(section_name, sections_);
+		return (position == index_.npos ? nullptr : sections_[position].get());
+	}
+
+	section &config::mutable_section(size_t index)
+	{
+		if (index >= sections_.size()) {
+			throw not_found_exception(index);
 		}
-		return *result;
+
+		section &result = unshared_section(index);
+		exposed_[index] = true;
+		return result;
 	}
 
-	bool config::contains(const std::string &section_name) const
+	section &config::mutable_section(std::string_view section_name)
 	{
-		try {
-			sections_map_.at(section_name);
-			return true;
-		} catch (std::out_of_range) {
-			return false;
+		size_t position = index_.find(section_name, sections_);
+		if (position == index_.npos) {
+			throw not_found_exception(std::string(section_name));
 		}
+		return mutable_section(position);
 	}
 
 	void config::validate(const schema &schm, schema_mode mode)
@@ -166,6 +213,11 @@ namespace inicpp
 		schm.validate_config(*this, mode);
 	}
 
+	void config::validate(const compiled_schema &plan, schema_mode mode)
+	{
+		plan.validate(*this, mode);
+	}
+
 	bool config::operator==(const config &other) const
 	{
 		return std::equal(sections_.begin(),
@@ -193,30 +245,27 @@ namespace inicpp
 
 	config::const_iterator config::begin() const
 	{
-		return const_iterator(const_cast<config &>(*this));
+		return const_iterator(*this);
 	}
 
 	config::const_iterator config::end() const
 	{
-		return const_iterator(const_cast<config &>(*this), sections_.size());
+		return const_iterator(*this, sections_.size());
 	}
 
 	config::const_iterator config::cbegin() const
 	{
-		return const_iterator(const_cast<config &>(*this));
+		return const_iterator(*this);
 	}
 
 	config::const_iterator config::cend() const
 	{
-		return const_iterator(const_cast<config &>(*this), sections_.size());
+		return const_iterator(*this, sections_.size());
 	}
 
 	std::ostream &operator<<(std::ostream &os, const config &conf)
 	{
-		for (auto &sect : conf.sections_) {
-			os << *sect;
-		}
-
+		serializer(os).write(conf);
 		return os;
 	}
 }
@@ -0,0 +1,93 @@
+#include "config_builder.h"
+#include "link_resolver.h"
+
+#include <utility>
+
+namespace inicpp
+{
+	config_builder::config_builder(index_policy policy)
+		: cfg_(policy), links_(std::make_unique<link_resolver>()), schema_(nullptr), mode_(schema_mode::relaxed),
+		  policy_(policy), section_schema_(nullptr)
+	{
+	}
+
+	config_builder::config_builder(const schema &schm, schema_mode mode, index_policy policy)
+		: cfg_(policy), links_(std::make_unique<link_resolver>()), schema_(&schm), mode_(mode), policy_(policy),
+		  section_schema_(nullptr)
+	{
+	}
+
+	config_builder::~config_builder()
+	{
+	}
+
+	void config_builder::flush_section()
+	{
+		if (last_section_ != nullptr) {
+			cfg_.add_section(std::move(*last_section_));
+		}
+	}
+
+	void config_builder::on_section(std::string_view name)
+	{
+		// if there is cached section, save it
+		flush_section();
+		last_section_ = std::make_shared<section>(std::string(name), policy_);
+
+		section_schema_ = nullptr;
+		if (schema_ != nullptr && schema_->contains(last_section_->get_name())) {
+			section_schema_ = &schema_->operator[](last_section_->get_name());
+		}
+	}
+
+	void config_builder::on_option(std::string_view name, std::vector<std::string> &values)
+	{
+		std::string option_name(name);
+		bool has_links = link_resolver::has_links(values);
+		std::vector<std::string> link_values;
+		if (has_links) {
+			link_values = values;
+		}
+		last_section_->add_option(option(option_name, std::move(values)));
+
+		// options keep their addresses when section is moved to config, links are resolved there
+		if (has_links) {
+			links_->add(link_resolver::added_option(*last_section_), std::move(link_values), get_line_number());
+		}
+
+		// typed values are parsed after links, so links to this option see its text
+		if (section_schema_ != nullptr && section_schema_->contains(option_name)) {
+			typed_options_.emplace_back(
+				&link_resolver::added_option(*last_section_), &section_schema_->operator[](option_name));
+		}
+	}
+
+	config config_builder::build()
+	{
+		// if there is cached section we have to add it to created config too
+		flush_section();
+		last_section_ = nullptr;
+		section_schema_ = nullptr;
+
+		config result = std::move(cfg_);
+		cfg_ = config(policy_);
+		auto links = std::move(links_);
+		links_ = std::make_unique<link_resolver>();
+		auto typed_options = std::move(typed_options_);
+		typed_options_.clear();
+
+		links->resolve(
+			[&result](const std::string &name) { return std::as_const(result).find(name); },
+			0,
+			links->size());
+
+		// options parsed by schema already have right types, so validation only checks them
+		if (schema_ != nullptr) {
+			for (auto &typed_option : typed_options) {
+				typed_option.second->parse_option(*typed_option.first);
+			}
+			result.validate(*schema_, mode_);
+		}
+		return result;
+	}
+}
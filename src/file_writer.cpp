@@ -0,0 +1,156 @@
+#include "file_writer.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define INICPP_HAS_POSIX_FILES
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inicpp
+{
+	namespace
+	{
+		/** Number of tries to create temporary file with unique name */
+		const size_t temp_file_attempts = 100;
+		/** Counter which makes names of temporary files of this process unique */
+		std::atomic<unsigned> temp_file_counter(0);
+
+#ifdef INICPP_HAS_POSIX_FILES
+		/**
+		 * Flush directory containing given file to the disk.
+		 * @param file name of the file
+		 * @return true if directory was flushed
+		 */
+		bool sync_parent_directory(const std::string &file)
+		{
+			size_t slash = file.rfind('/');
+			std::string directory = (slash == std::string::npos ? "." : file.substr(0, slash == 0 ? 1 : slash));
+			int fd = open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) {
+				return false;
+			}
+			bool synced = fsync(fd) == 0;
+			close(fd);
+			return synced;
+		}
+#endif
+	}
+
+	file_writer::file_writer(const std::string &file, const save_params &params)
+		: file_(file), fd_(-1), params_(params)
+	{
+#ifdef INICPP_HAS_POSIX_FILES
+		if (!params_.atomic) {
+			fd_ = open(file_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+		} else {
+			// temporary file is in the same directory, so rename stays on one file system
+			std::string prefix = file_ + ".tmp" + std::to_string(getpid()) + ".";
+			for (size_t i = 0; i < temp_file_attempts && fd_ < 0; ++i) {
+				temp_file_ = prefix + std::to_string(temp_file_counter++);
+				fd_ = open(temp_file_.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+				if (fd_ < 0 && errno != EEXIST) {
+					break;
+				}
+			}
+
+			// replaced file keeps its permissions, save fails if they cannot be copied
+			struct stat info;
+			if (fd_ >= 0 && stat(file_.c_str(), &info) == 0 && S_ISREG(info.st_mode) &&
+				fchmod(fd_, info.st_mode & 07777) != 0) {
+				close(fd_);
+				fd_ = -1;
+				std::remove(temp_file_.c_str());
+			}
+		}
+		if (fd_ < 0) {
+			temp_file_.clear();
+			throw parser_exception("File writing error");
+		}
+		output_ = std::make_unique<serializer>(fd_, params_.buffer_size);
+#else
+		if (params_.atomic) {
+			temp_file_ = file_ + ".tmp" + std::to_string(temp_file_counter++);
+		}
+		stream_.open(params_.atomic ? temp_file_ : file_);
+		if (stream_.fail()) {
+			temp_file_.clear();
+			throw parser_exception("File writing error");
+		}
+		output_ = std::make_unique<serializer>(stream_, params_.buffer_size);
+#endif
+	}
+
+	file_writer::~file_writer()
+	{
+		discard();
+	}
+
+	void file_writer::discard() noexcept
+	{
+		// remaining data are flushed to our own file before it is closed
+		output_.reset();
+#ifdef INICPP_HAS_POSIX_FILES
+		if (fd_ >= 0) {
+			close(fd_);
+			fd_ = -1;
+		}
+#else
+		stream_.close();
+#endif
+		if (!temp_file_.empty()) {
+			std::remove(temp_file_.c_str());
+			temp_file_.clear();
+		}
+	}
+
+	serializer &file_writer::output()
+	{
+		return *output_;
+	}
+
+	void file_writer::commit()
+	{
+		output_->flush();
+		output_.reset();
+
+#ifdef INICPP_HAS_POSIX_FILES
+		// data have to be on the disk before the rename makes them visible
+		if (params_.atomic && fsync(fd_) != 0) {
+			throw parser_exception("File writing error");
+		}
+		int fd = fd_;
+		fd_ = -1;
+		if (close(fd) != 0) {
+			throw parser_exception("File writing error");
+		}
+		if (params_.atomic) {
+			if (rename(temp_file_.c_str(), file_.c_str()) != 0) {
+				throw parser_exception("File writing error");
+			}
+			temp_file_.clear();
+			// target already has the new content here, only its durability is unknown
+			if (params_.sync_directory && !sync_parent_directory(file_)) {
+				throw parser_exception("File was replaced, but its directory could not be flushed");
+			}
+		}
+#else
+		stream_.close();
+		if (stream_.fail()) {
+			throw parser_exception("File writing error");
+		}
+		if (params_.atomic) {
+			// rename cannot replace existing file here
+			std::remove(file_.c_str());
+			if (std::rename(temp_file_.c_str(), file_.c_str()) != 0) {
+				throw parser_exception("File writing error");
+			}
+			temp_file_.clear();
+		}
+#endif
+	}
+}
@@ -0,0 +1,84 @@
+#ifndef INICPP_FILE_WRITER_H
+#define INICPP_FILE_WRITER_H
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "save_params.h"
+#include "serializer.h"
+
+namespace inicpp
+{
+	/**
+	 * Output file for serializer. In atomic mode data are written into temporary
+	 * file next to the target, which replaces the target only in commit().
+	 * Temporary file is removed if writer is destroyed without commit, so failed
+	 * save keeps the original file untouched, unless only flushing of the directory
+	 * after the rename failed. On platforms without POSIX file API
+	 * streams are used and replacing of the target is not atomic.
+	 */
+	class file_writer
+	{
+	private:
+		/** Name of the target file */
+		std::string file_;
+		/** Name of the written temporary file, empty if target is written directly */
+		std::string temp_file_;
+		/** Descriptor of written file, -1 if closed or streams are used */
+		int fd_;
+		/** Written file if POSIX file API is not available */
+		std::ofstream stream_;
+		/** Serializer writing into the file */
+		std::unique_ptr<serializer> output_;
+		/** Parameters of saving */
+		save_params params_;
+
+		/**
+		 * Close the file and remove temporary file, errors are ignored.
+		 */
+		void discard() noexcept;
+
+	public:
+		/**
+		 * Deleted default constructor.
+		 */
+		file_writer() = delete;
+		/**
+		 * Deleted copy constructor.
+		 */
+		file_writer(const file_writer &source) = delete;
+		/**
+		 * Deleted copy assignment.
+		 */
+		file_writer &operator=(const file_writer &source) = delete;
+
+		/**
+		 * Create temporary file, or truncate the target if atomic mode is not used.
+		 * @param file name of the target file
+		 * @param params parameters of saving
+		 * @throws parser_exception if file cannot be created
+		 */
+		file_writer(const std::string &file, const save_params &params);
+		/**
+		 * Discards written data if they were not committed.
+		 */
+		~file_writer();
+
+		/**
+		 * Serializer writing into the file.
+		 * @return reference to serializer
+		 */
+		serializer &output();
+		/**
+		 * Write all data and close the file. In atomic mode file is flushed
+		 * to the disk and renamed over the target.
+		 * @throws parser_exception if any write fails, target is untouched then in atomic mode.
+		 * The only exception is failed flush of the directory after the rename,
+		 * target has the new content then, but it may not survive a system crash.
+		 */
+		void commit();
+	};
+}
+
+#endif // INICPP_FILE_WRITER_H
@@ -0,0 +1,48 @@
+#include "identifier_validator.h"
+
+namespace inicpp
+{
+	identifier_validator::identifier_validator() : identifier_validator("a-zA-Z.$:", "-a-zA-Z0-9_~.:$ ")
+	{
+	}
+
+	identifier_validator::identifier_validator(std::string_view first_chars, std::string_view other_chars)
+	{
+		table_.fill(0);
+		add_chars(first_chars, first_flag);
+		add_chars(other_chars, other_flag);
+	}
+
+	void identifier_validator::add_chars(std::string_view chars, unsigned char flag)
+	{
+		for (size_t i = 0; i < chars.length(); ++i) {
+			unsigned char from = static_cast<unsigned char>(chars[i]);
+			unsigned char to = from;
+
+			// dash between two characters denotes range
+			if (i + 2 < chars.length() && chars[i + 1] == '-') {
+				to = static_cast<unsigned char>(chars[i + 2]);
+				i += 2;
+			}
+
+			for (unsigned int ch = from; ch <= to; ++ch) {
+				table_[ch] |= flag;
+			}
+		}
+	}
+
+	bool identifier_validator::is_valid(std::string_view str) const
+	{
+		if (str.empty() || !(table_[static_cast<unsigned char>(str[0])] & first_flag)) {
+			return false;
+		}
+
+		for (size_t i = 1; i < str.length(); ++i) {
+			if (!(table_[static_cast<unsigned char>(str[i])] & other_flag)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
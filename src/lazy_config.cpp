@@ -0,0 +1,262 @@
+#include "lazy_config.h"
+#include "link_resolver.h"
+#include "mapped_file.h"
+#include "parser.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace inicpp
+{
+	/**
+	 * Handler which fills one section of lazy config.
+	 */
+	class lazy_config::section_builder : public parse_handler
+	{
+	private:
+		/** Graph in which links are recorded */
+		link_resolver &links_;
+		/** Filled section */
+		section &section_;
+
+	public:
+		/**
+		 * Construct builder of given section.
+		 * @param links graph in which links are recorded
+		 * @param sect filled section
+		 */
+		section_builder(link_resolver &links, section &sect) : links_(links), section_(sect)
+		{
+		}
+
+		void on_option(std::string_view name, std::vector<std::string> &values) override
+		{
+			std::string option_name(name);
+			bool has_links = link_resolver::has_links(values);
+			std::vector<std::string> link_values;
+			if (has_links) {
+				link_values = values;
+			}
+
+			section_.add_option(option(option_name, std::move(values)));
+
+			if (has_links) {
+				links_.add(link_resolver::added_option(section_), std::move(link_values), get_line_number());
+			}
+		}
+	};
+
+	namespace
+	{
+		/**
+		 * Handler which extracts name of the section from its header line.
+		 */
+		class section_name_handler : public parse_handler
+		{
+		public:
+			/** Name of the section */
+			std::string name;
+
+			void on_section(std::string_view section_name) override
+			{
+				name = section_name;
+			}
+		};
+	}
+
+
+	lazy_config::lazy_config(const load_params &params)
+		: params_(params), mode_(schema_mode::relaxed), links_(std::make_unique<link_resolver>())
+	{
+	}
+
+	lazy_config::lazy_config(lazy_config &&source) = default;
+
+	lazy_config &lazy_config::operator=(lazy_config &&source) = default;
+
+	lazy_config::~lazy_config()
+	{
+	}
+
+	std::string_view lazy_config::text() const
+	{
+		if (mapping_ != nullptr) {
+			return mapping_->data();
+		}
+		return buffer_;
+	}
+
+	void lazy_config::build_index(const schema *schm, schema_mode mode)
+	{
+		std::string_view str = text();
+		size_t line_number = 0;
+		size_t first_section = str.length();
+
+		// only lines which start a section are inspected, no other line is parsed
+		for (size_t pos = 0; pos < str.length();) {
+			const void *newline = std::memchr(str.data() + pos, '\n', str.length() - pos);
+			size_t line_end = (newline == nullptr ? str.length() : static_cast<const char *>(newline) - str.data());
+			line_number++;
+
+			if (parser::starts_section(str.substr(pos, line_end - pos))) {
+				section_name_handler handler;
+				parser::internal_parse(str.substr(pos, line_end - pos), handler, params_, line_number - 1);
+
+				// open section ends here
+				if (!entries_.empty() && entries_.back().end == str.length()) {
+					entries_.back().end = pos;
+				}
+				first_section = std::min(first_section, pos);
+
+				// section which is not selected has no entry
+				if (!handler.name.empty()) {
+					if (!index_.emplace(handler.name, entries_.size()).second) {
+						throw ambiguity_exception(handler.name);
+					}
+					entries_.push_back(
+						section_entry{handler.name, pos, str.length(), line_number - 1, nullptr, 0, 0, false});
+				}
+			}
+
+			pos = line_end + 1;
+		}
+
+		// text before the first section can contain only comments
+		parse_handler prefix_handler;
+		parser::internal_parse(str.substr(0, first_section), prefix_handler, params_);
+
+		if (schm == nullptr) {
+			return;
+		}
+
+		// names of the sections are checked right now, contents of sections on access
+		schema_ = std::make_unique<schema>(*schm);
+		mode_ = mode;
+		for (size_t i = 0; i < schema_->size(); ++i) {
+			auto &sect_schema = schema_->operator[](i);
+			if (contains(sect_schema.get_name())) {
+				continue;
+			}
+
+			if (sect_schema.is_mandatory()) {
+				throw validation_exception("Mandatory section '" + sect_schema.get_name() + "' is missing in config");
+			}
+
+			// section which is not in config is added with default values of its options
+			index_.emplace(sect_schema.get_name(), entries_.size());
+			entries_.push_back(section_entry{sect_schema.get_name(), std::string::npos, 0, 0, nullptr, 0, 0, true});
+		}
+
+		if (mode == schema_mode::strict) {
+			for (auto &entry : entries_) {
+				if (!schema_->contains(entry.name)) {
+					throw validation_exception("Section '" + entry.name + "' not specified in schema");
+				}
+			}
+		}
+	}
+
+	section &lazy_config::parse_section(size_t index)
+	{
+		section_entry &entry = entries_[index];
+		if (entry.parsed != nullptr) {
+			return *entry.parsed;
+		}
+
+		auto sect = std::make_unique<section>(entry.name, params_.index);
+		if (entry.begin == std::string::npos) {
+			auto &sect_schema = schema_->operator[](entry.name);
+			for (size_t i = 0; i < sect_schema.size(); ++i) {
+				auto &opt = sect_schema[i];
+				sect->add_option(opt.get_name(), opt.get_default_value());
+			}
+		} else {
+			// options of one section are recorded in the link graph next to each other
+			section_builder builder(*links_, *sect);
+			size_t first_link = links_->size();
+			try {
+				parser::internal_parse(
+					text().substr(entry.begin, entry.end - entry.begin), builder, params_, entry.line_offset);
+			} catch (...) {
+				// recorded nodes point to options of the destroyed section
+				links_->truncate(first_link);
+				throw;
+			}
+			entry.first_link = first_link;
+			entry.last_link = links_->size();
+		}
+
+		entry.parsed = std::move(sect);
+		return *entry.parsed;
+	}
+
+	section &lazy_config::get_section(size_t index)
+	{
+		section_entry &entry = entries_[index];
+		section &sect = parse_section(index);
+
+		// linked sections are parsed, but they are validated only when accessed
+		links_->resolve(
+			[this](const std::string &name) -> const section * {
+				auto sect_it = index_.find(name);
+				return (sect_it == index_.end() ? nullptr : &parse_section(sect_it->second));
+			},
+			entry.first_link,
+			entry.last_link);
+
+		if (!entry.validated) {
+			if (schema_ != nullptr && schema_->contains(entry.name)) {
+				schema_->operator[](entry.name).validate_section(sect, mode_);
+			}
+			entry.validated = true;
+		}
+
+		return sect;
+	}
+
+	size_t lazy_config::size() const
+	{
+		return entries_.size();
+	}
+
+	section &lazy_config::operator[](size_t index)
+	{
+		if (index >= entries_.size()) {
+			throw not_found_exception(index);
+		}
+		return get_section(index);
+	}
+
+	section &lazy_config::operator[](std::string_view section_name)
+	{
+		auto sect_it = index_.find(section_name);
+		if (sect_it == index_.end()) {
+			throw not_found_exception(std::string(section_name));
+		}
+		return get_section(sect_it->second);
+	}
+
+	bool lazy_config::contains(std::string_view section_name) const
+	{
+		return index_.find(section_name) != index_.end();
+	}
+
+	bool lazy_config::is_parsed(std::string_view section_name) const
+	{
+		auto sect_it = index_.find(section_name);
+		if (sect_it == index_.end()) {
+			throw not_found_exception(std::string(section_name));
+		}
+		return entries_[sect_it->second].parsed != nullptr;
+	}
+
+	lazy_config::iterator lazy_config::begin()
+	{
+		return iterator(*this, 0);
+	}
+
+	lazy_config::iterator lazy_config::end()
+	{
+		return iterator(*this, entries_.size());
+	}
+}
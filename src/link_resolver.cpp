@@ -0,0 +1,131 @@
+#include "link_resolver.h"
+#include "parser.h"
+
+#include <algorithm>
+
+namespace inicpp
+{
+	bool link_resolver::has_links(const std::vector<std::string> &values)
+	{
+		for (auto &value : values) {
+			if (parser::is_link(value)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	option &link_resolver::added_option(section &sect)
+	{
+		return sect.unshared_option(sect.size() - 1);
+	}
+
+	void link_resolver::add(option &opt, std::vector<std::string> values, size_t line_number)
+	{
+		index_.emplace(&opt, nodes_.size());
+		nodes_.push_back(link_node{&opt, std::move(values), line_number, node_state::unresolved});
+	}
+
+	void link_resolver::truncate(size_t count)
+	{
+		for (size_t i = count; i < nodes_.size(); ++i) {
+			index_.erase(nodes_[i].opt);
+		}
+		nodes_.erase(nodes_.begin() + std::min(count, nodes_.size()), nodes_.end());
+	}
+
+	size_t link_resolver::size() const
+	{
+		return nodes_.size();
+	}
+
+	const option &link_resolver::find_target(
+		const std::string &link, const section_lookup &lookup, size_t line_number) const
+	{
+		// format of the link was already checked by lexer
+		std::string_view sect_view, opt_view;
+		parser::split_link(link, sect_view, opt_view);
+		std::string opt_link(opt_view);
+
+		const section *selected_section = lookup(std::string(sect_view));
+		if (selected_section == nullptr) {
+			throw parser_exception("Bad link on line " + std::to_string(line_number));
+		}
+		if (!selected_section->contains(opt_link)) {
+			throw parser_exception("Option name in link not found on line " + std::to_string(line_number));
+		}
+
+		return selected_section->operator[](opt_link);
+	}
+
+	void link_resolver::resolve(const section_lookup &lookup, size_t begin, size_t end)
+	{
+		// nodes on the path of depth-first search with position of the next value to resolve
+		std::vector<std::pair<size_t, size_t>> stack;
+
+		try {
+			for (size_t i = begin; i < end; ++i) {
+				if (nodes_[i].state != node_state::unresolved) {
+					continue;
+				}
+
+				nodes_[i].state = node_state::in_progress;
+				stack.emplace_back(i, 0);
+
+				while (!stack.empty()) {
+					auto &top = stack.back();
+					size_t node_index = top.first;
+					size_t &value_index = top.second;
+
+					// resolve values of the node until unresolved dependency is found
+					bool descended = false;
+					while (value_index < nodes_[node_index].values.size()) {
+						link_node &node = nodes_[node_index];
+						std::string &value = node.values[value_index];
+						if (!parser::is_link(value)) {
+							value_index++;
+							continue;
+						}
+
+						// lookup can parse new sections, node references are not valid afterwards
+						const option &target = find_target(value, lookup, node.line_number);
+						auto target_it = index_.find(&target);
+						if (target_it != index_.end()) {
+							link_node &target_node = nodes_[target_it->second];
+							if (target_node.state == node_state::in_progress) {
+								throw parser_exception(
+									"Cyclic link on line " + std::to_string(nodes_[node_index].line_number));
+							}
+							if (target_node.state == node_state::unresolved) {
+								target_node.state = node_state::in_progress;
+								stack.emplace_back(target_it->second, 0);
+								descended = true;
+								break;
+							}
+						}
+
+						nodes_[node_index].values[value_index] = target.get<string_ini_t>();
+						value_index++;
+					}
+
+					if (descended) {
+						continue;
+					}
+
+					// all values are resolved, store them to the option
+					link_node &node = nodes_[node_index];
+					*node.opt = option(node.opt->get_name(), std::move(node.values));
+					node.values.clear();
+					node.state = node_state::resolved;
+					stack.pop_back();
+				}
+			}
+		} catch (...) {
+			// nodes on the path stay unresolved, so the same error is reported again
+			for (auto &item : stack) {
+				nodes_[item.first].state = node_state::unresolved;
+			}
+			throw;
+		}
+	}
+}
@@ -0,0 +1,111 @@
+#ifndef INICPP_LINK_RESOLVER_H
+#define INICPP_LINK_RESOLVER_H
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "option.h"
+#include "section.h"
+
+namespace inicpp
+{
+	/**
+	 * Graph of links between options. Options which contain links "${section#option}"
+	 * are recorded as nodes while parsing and links are resolved afterwards, so they
+	 * can point forward as well as backward. Nodes are resolved in topological order
+	 * by iterative depth-first search, value of every node is computed only once,
+	 * regardless of the number of options which link to it. Cycles are reported as errors.
+	 */
+	class link_resolver
+	{
+	public:
+		/**
+		 * Function which finds section with given name.
+		 * Returned section has to stay valid during resolution.
+		 * @return pointer to section or nullptr if there is no such section
+		 */
+		using section_lookup = std::function<const section *(const std::string &)>;
+
+	private:
+		/** Resolution state of the node */
+		enum class node_state : unsigned char { unresolved, in_progress, resolved };
+
+		/**
+		 * Option with links.
+		 */
+		struct link_node {
+			/** Option which values will be replaced */
+			option *opt;
+			/** Values of the option with unresolved links */
+			std::vector<std::string> values;
+			/** Line on which option was defined */
+			size_t line_number;
+			/** Resolution state */
+			node_state state;
+		};
+
+		/** All recorded nodes */
+		std::vector<link_node> nodes_;
+		/** Indexes of nodes by their options */
+		std::unordered_map<const option *, size_t> index_;
+
+		/**
+		 * Find option which is target of given link.
+		 * @param link value of the option which is link
+		 * @param lookup function which finds sections
+		 * @param line_number line of the linking option
+		 * @return linked option
+		 * @throws parser_exception if section or option does not exist
+		 */
+		const option &find_target(const std::string &link, const section_lookup &lookup, size_t line_number) const;
+
+	public:
+		/**
+		 * Determines if given values contain a link.
+		 * @param values option values
+		 * @return true if at least one value is link
+		 */
+		static bool has_links(const std::vector<std::string> &values);
+		/**
+		 * Last option added to the section while parsing, it is recorded as node.
+		 * Option is not marked as given out by the section, reference is used only
+		 * until links are resolved.
+		 * @param sect section which contains at least one option
+		 * @return modifiable reference to the option
+		 */
+		static option &added_option(section &sect);
+
+		/**
+		 * Record option with links. Option has to stay on the same address until it is resolved.
+		 * @param opt option which contains links
+		 * @param values values of the option with unresolved links
+		 * @param line_number line on which option was defined
+		 */
+		void add(option &opt, std::vector<std::string> values, size_t line_number);
+		/**
+		 * Drop nodes recorded after given number of nodes, it is used when parsing
+		 * of their section failed and their options are destroyed.
+		 * @param count number of nodes which are kept
+		 */
+		void truncate(size_t count);
+		/**
+		 * Number of recorded nodes.
+		 * @return unsigned integer
+		 */
+		size_t size() const;
+		/**
+		 * Resolve links of given range of nodes and of all nodes they depend on.
+		 * Options of resolved nodes get values with links replaced by the first value
+		 * of linked option. Lookup may parse new sections and record their nodes.
+		 * @param lookup function which finds sections
+		 * @param begin index of the first node
+		 * @param end index after the last node
+		 * @throws parser_exception if link cannot be resolved or links form a cycle
+		 */
+		void resolve(const section_lookup &lookup, size_t begin, size_t end);
+	};
+}
+
+#endif // INICPP_LINK_RESOLVER_H
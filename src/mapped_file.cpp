@@ -0,0 +1,81 @@
+#include "mapped_file.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define INICPP_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inicpp
+{
+	mapped_file::mapped_file(const std::string &file) : data_(nullptr), size_(0)
+	{
+#ifdef INICPP_HAS_MMAP
+		// check type of the file before opening it, opening of pipe could block
+		//   and data read by us would be lost for the stream fallback
+		struct stat info;
+		if (stat(file.c_str(), &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+			return;
+		}
+
+		int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			return;
+		}
+
+		// file could have been replaced in the meantime, so check it once more
+		if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+			size_t size = static_cast<size_t>(info.st_size);
+			void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (addr != MAP_FAILED) {
+				// file is parsed from start to end, so let the kernel read ahead
+				madvise(addr, size, MADV_SEQUENTIAL);
+				madvise(addr, size, MADV_WILLNEED);
+				data_ = static_cast<const char *>(addr);
+				size_ = size;
+			}
+		}
+
+		// mapping stays valid even after closing the descriptor
+		close(fd);
+#else
+		(void) file;
+#endif
+	}
+
+	mapped_file::mapped_file(mapped_file &&source) noexcept : data_(source.data_), size_(source.size_)
+	{
+		source.data_ = nullptr;
+		source.size_ = 0;
+	}
+
+	mapped_file &mapped_file::operator=(mapped_file &&source) noexcept
+	{
+		if (this != &source) {
+			std::swap(data_, source.data_);
+			std::swap(size_, source.size_);
+		}
+		return *this;
+	}
+
+	mapped_file::~mapped_file()
+	{
+#ifdef INICPP_HAS_MMAP
+		if (data_ != nullptr) {
+			munmap(const_cast<char *>(data_), size_);
+		}
+#endif
+	}
+
+	bool mapped_file::is_mapped() const
+	{
+		return data_ != nullptr;
+	}
+
+	std::string_view mapped_file::data() const
+	{
+		return std::string_view(data_, size_);
+	}
+}
@@ -0,0 +1,70 @@
+#ifndef INICPP_MAPPED_FILE_H
+#define INICPP_MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+
+namespace inicpp
+{
+	/**
+	 * Read-only memory mapping of whole regular file. Mapping is hinted
+	 * to the kernel as sequentially read, so readahead can be used.
+	 * If file cannot be mapped (pipes, special files, empty files
+	 * or platforms without mmap) instance stays unmapped and caller
+	 * is expected to fall back to stream reading.
+	 */
+	class mapped_file
+	{
+	private:
+		/** Beginning of the mapping, nullptr if not mapped */
+		const char *data_;
+		/** Length of the mapping in bytes */
+		size_t size_;
+
+	public:
+		/**
+		 * Deleted default constructor.
+		 */
+		mapped_file() = delete;
+		/**
+		 * Deleted copy constructor.
+		 */
+		mapped_file(const mapped_file &source) = delete;
+		/**
+		 * Deleted copy assignment.
+		 */
+		mapped_file &operator=(const mapped_file &source) = delete;
+		/**
+		 * Move constructor.
+		 */
+		mapped_file(mapped_file &&source) noexcept;
+		/**
+		 * Move assignment.
+		 */
+		mapped_file &operator=(mapped_file &&source) noexcept;
+
+		/**
+		 * Try to map file with given name. No exception is thrown
+		 * if mapping fails, check it with is_mapped().
+		 * @param file name of mapped file
+		 */
+		explicit mapped_file(const std::string &file);
+		/**
+		 * Unmaps the file.
+		 */
+		~mapped_file();
+
+		/**
+		 * Determines if file was successfully mapped.
+		 * @return true if content is available through data()
+		 */
+		bool is_mapped() const;
+		/**
+		 * Content of mapped file.
+		 * @return view to whole file content, empty if not mapped
+		 */
+		std::string_view data() const;
+	};
+}
+
+#endif // INICPP_MAPPED_FILE_H
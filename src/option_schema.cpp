@@ -1,4 +1,5 @@
 #include "option_schema.h"
+#include "serializer.h"
 #include "string_utils.h"
 
 namespace inicpp
@@ -28,12 +29,12 @@ namespace inicpp
 		return *this;
 	}
 
-	option_schema::option_schema(option_schema &&source)
+	option_schema::option_schema(option_schema &&source) noexcept
+		: type_(source.type_), params_(std::move(source.params_))
 	{
-		this->operator=(std::move(source));
 	}
 
-	option_schema &option_schema::operator=(option_schema &&source)
+	option_schema &option_schema::operator=(option_schema &&source) noexcept
 	{
 		if (this != &source) {
 			type_ = source.type_;
@@ -89,28 +90,30 @@ namespace inicpp
 		validate_option_items(opt);
 	}
 
+	template <typename ValueType> void option_schema::validate_typed_option_items(const option &opt) const
+	{
+		// values are not copied out of the option if there is nothing to validate
+		option_schema_params<ValueType> *ptr = dynamic_cast<option_schema_params<ValueType> *>(&*params_);
+		if (ptr == nullptr || ptr->validator == nullptr) {
+			return;
+		}
+		for (const auto &item : opt.get_list<ValueType>()) {
+			if (!ptr->validator(item)) {
+				throw validation_exception("Option '" + opt.get_name() + "' - validation failed");
+			}
+		}
+	}
+
 	void option_schema::validate_option_items(option &opt) const
 	{
 		// load value and call validate function on it
 		switch (type_) {
-		case option_type::boolean_e:
-			validate_typed_option_items<boolean_ini_t>(opt.get_list<boolean_ini_t>(), opt.get_name());
-			break;
-		case option_type::enum_e:
-			validate_typed_option_items<enum_ini_t>(opt.get_list<enum_ini_t>(), opt.get_name());
-			break;
-		case option_type::float_e:
-			validate_typed_option_items<float_ini_t>(opt.get_list<float_ini_t>(), opt.get_name());
-			break;
-		case option_type::signed_e:
-			validate_typed_option_items<signed_ini_t>(opt.get_list<signed_ini_t>(), opt.get_name());
-			break;
-		case option_type::string_e:
-			validate_typed_option_items<string_ini_t>(opt.get_list<string_ini_t>(), opt.get_name());
-			break;
-		case option_type::unsigned_e:
-			validate_typed_option_items<unsigned_ini_t>(opt.get_list<unsigned_ini_t>(), opt.get_name());
-			break;
+		case option_type::boolean_e: validate_typed_option_items<boolean_ini_t>(opt); break;
+		case option_type::enum_e: validate_typed_option_items<enum_ini_t>(opt); break;
+		case option_type::float_e: validate_typed_option_items<float_ini_t>(opt); break;
+		case option_type::signed_e: validate_typed_option_items<signed_ini_t>(opt); break;
+		case option_type::string_e: validate_typed_option_items<string_ini_t>(opt); break;
+		case option_type::unsigned_e: validate_typed_option_items<unsigned_ini_t>(opt); break;
 		case option_type::invalid_e:
 			// never reached
 			throw invalid_type_exception("Option '" + opt.get_name() + "' - invalid option type");
@@ -120,29 +123,37 @@ namespace inicpp
 
 	void option_schema::parse_option_items(option &opt) const
 	{
+		// strings are parsed in place, other types are converted to strings first
+		std::vector<std::string> converted;
+		const std::vector<std::string> *items = opt.typed_values<string_ini_t>();
+		if (items == nullptr && type_ != option_type::string_e) {
+			converted = opt.get_list<string_ini_t>();
+			items = &converted;
+		}
+
 		switch (type_) {
 		case option_type::boolean_e:
 			opt.set_list<boolean_ini_t>(parse_typed_option_items<boolean_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<boolean_ini_t>, opt.get_name()));
+				*items, string_utils::parse_string<boolean_ini_t>, opt.get_name()));
 			break;
 		case option_type::enum_e:
 			opt.set_list<enum_ini_t>(parse_typed_option_items<enum_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<enum_ini_t>, opt.get_name()));
+				*items, string_utils::parse_string<enum_ini_t>, opt.get_name()));
 			break;
 		case option_type::float_e:
 			opt.set_list<float_ini_t>(parse_typed_option_items<float_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<float_ini_t>, opt.get_name()));
+				*items, string_utils::parse_string<float_ini_t>, opt.get_name()));
 			break;
 		case option_type::signed_e:
 			opt.set_list<signed_ini_t>(parse_typed_option_items<signed_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<signed_ini_t>, opt.get_name()));
+				*items, string_utils::parse_string<signed_ini_t>, opt.get_name()));
 			break;
 		case option_type::string_e:
 			// string doesn't need to be parsed
 			break;
 		case option_type::unsigned_e:
 			opt.set_list<unsigned_ini_t>(parse_typed_option_items<unsigned_ini_t>(
-				opt.get_list<string_ini_t>(), string_utils::parse_string<unsigned_ini_t>, opt.get_name()));
+				*items, string_utils::parse_string<unsigned_ini_t>, opt.get_name()));
 			break;
 		case option_type::invalid_e:
 			// never reached
@@ -151,34 +162,26 @@ namespace inicpp
 		}
 	}
 
-	std::ostream &option_schema::write_additional_info(std::ostream &os) const
+	void option_schema::parse_option(option &opt) const
 	{
-		// write comment
-		auto comment_lines = string_utils::split(get_comment(), '\n');
-		for (auto &comment_line : comment_lines) {
-			os << ";" << comment_line << std::endl;
+		// wrong number of values is reported by validation, so it takes precedence over parsing errors
+		const std::vector<std::string> *values = opt.typed_values<string_ini_t>();
+		bool list = params_->type == option_item::list;
+		if (type_ == option_type::string_e || values == nullptr || list != (values->size() > 1)) {
+			return;
 		}
+		parse_option_items(opt);
+	}
 
-		// optional/mandatory and single/list
-		std::string info_line = is_mandatory() ? "mandatory" : "optional";
-		info_line += ", ";
-		info_line += is_list() ? "list" : "single";
-		os << ";<" << info_line << ">" << std::endl;
-
-		// default value given at construction
-		os << ";<default value: \"" << get_default_value() << "\">" << std::endl;
-
+	std::ostream &option_schema::write_additional_info(std::ostream &os) const
+	{
+		serializer(os).write_info(*this);
 		return os;
 	}
 
 	std::ostream &operator<<(std::ostream &os, const option_schema &opt_schema)
 	{
-		// write additional information about given option
-		opt_schema.write_additional_info(os);
-
-		// write name and default value
-		os << opt_schema.get_name() << " = " << opt_schema.get_default_value() << std::endl;
-
+		serializer(os).write(opt_schema);
 		return os;
 	}
 }
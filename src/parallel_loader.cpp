@@ -0,0 +1,213 @@
+#include "parallel_loader.h"
+#include "link_resolver.h"
+
+#include <algorithm>
+#include <deque>
+#include <cstring>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace inicpp
+{
+	/**
+	 * Option which contains links, they are resolved after merge.
+	 */
+	struct parallel_loader::link_entry {
+		/** Option with links, it keeps its address when section is moved to config */
+		option *opt;
+		/** Values of the option with unresolved links */
+		std::vector<std::string> values;
+		/** Line on which option was defined */
+		size_t line_number;
+	};
+
+	/**
+	 * Result of parsing of one range.
+	 */
+	struct parallel_loader::range {
+		/** Sections in order of appearance */
+		std::deque<section> sections;
+		/** Options with links in order of appearance */
+		std::vector<link_entry> links;
+		/** First error in the range, parsing of the range was stopped on it */
+		std::exception_ptr error;
+	};
+
+	/**
+	 * Handler which collects sections of one range.
+	 */
+	class parallel_loader::range_builder : public parse_handler
+	{
+	private:
+		/** Filled result */
+		range &range_;
+		/** Index policy of created sections */
+		index_policy policy_;
+
+	public:
+		/**
+		 * Construct builder which fills given range.
+		 * @param rng result of parsing
+		 * @param policy index policy of created sections
+		 */
+		range_builder(range &rng, index_policy policy) : range_(rng), policy_(policy)
+		{
+		}
+
+		void on_section(std::string_view name) override
+		{
+			range_.sections.emplace_back(std::string(name), policy_);
+		}
+
+		void on_option(std::string_view name, std::vector<std::string> &values) override
+		{
+			section &sect = range_.sections.back();
+			std::string option_name(name);
+			bool has_links = link_resolver::has_links(values);
+			std::vector<std::string> link_values;
+			if (has_links) {
+				link_values = values;
+			}
+
+			sect.add_option(option(option_name, std::move(values)));
+
+			if (has_links) {
+				range_.links.push_back(
+					link_entry{&link_resolver::added_option(sect), std::move(link_values), get_line_number()});
+			}
+		}
+	};
+
+
+	std::vector<size_t> parallel_loader::split(std::string_view str, size_t count)
+	{
+		std::vector<size_t> result = {0};
+
+		for (size_t i = 1; i < count; ++i) {
+			size_t pos = std::max(str.length() / count * i, result.back());
+
+			// move to the start of the next line which opens a section
+			while (true) {
+				const void *newline = std::memchr(str.data() + pos, '\n', str.length() - pos);
+				if (newline == nullptr) {
+					pos = str.length();
+					break;
+				}
+				pos = static_cast<const char *>(newline) - str.data() + 1;
+
+				const void *line_end = std::memchr(str.data() + pos, '\n', str.length() - pos);
+				size_t length = (line_end == nullptr ? str.length() : static_cast<const char *>(line_end) - str.data()) - pos;
+				if (parser::starts_section(str.substr(pos, length))) {
+					break;
+				}
+			}
+
+			if (pos == str.length()) {
+				break;
+			}
+			if (pos != result.back()) {
+				result.push_back(pos);
+			}
+		}
+
+		result.push_back(str.length());
+		return result;
+	}
+
+	size_t parallel_loader::thread_count(std::string_view str, const load_params &params)
+	{
+		size_t threads = params.threads;
+		if (threads == 0) {
+			threads = std::thread::hardware_concurrency();
+		}
+
+		return std::max<size_t>(std::min(threads, str.length() / min_range_size), 1);
+	}
+
+	config parallel_loader::load(std::string_view str, size_t threads, const load_params &params)
+	{
+		std::vector<size_t> bounds = split(str, threads);
+		size_t count = bounds.size() - 1;
+
+		// runs given function for all ranges, the last one (and those without thread) on calling thread
+		auto run = [count](auto function) {
+			std::vector<std::thread> workers;
+			workers.reserve(count - 1);
+			// started workers must be joined on every path, destroying joinable thread terminates program
+			auto join = [&workers]() {
+				for (auto &worker : workers) {
+					worker.join();
+				}
+			};
+			size_t started = 0;
+			try {
+				for (; started + 1 < count; ++started) {
+					workers.emplace_back(function, started);
+				}
+			} catch (const std::system_error &) {
+				// no more threads can be started, remaining ranges are run on calling thread
+			} catch (...) {
+				join();
+				throw;
+			}
+			try {
+				for (size_t i = started; i < count; ++i) {
+					function(i);
+				}
+			} catch (...) {
+				join();
+				throw;
+			}
+			join();
+		};
+
+		// count lines first, so workers can report correct line numbers
+		std::vector<size_t> line_offsets(count + 1, 0);
+		run([&](size_t i) {
+			line_offsets[i + 1] = std::count(str.begin() + bounds[i], str.begin() + bounds[i + 1], '\n');
+		});
+		for (size_t i = 0; i < count; ++i) {
+			line_offsets[i + 1] += line_offsets[i];
+		}
+
+		std::vector<range> ranges(count);
+		run([&](size_t i) {
+			range_builder builder(ranges[i], params.index);
+			try {
+				parser::internal_parse(
+					str.substr(bounds[i], bounds[i + 1] - bounds[i]), builder, params, line_offsets[i]);
+			} catch (...) {
+				ranges[i].error = std::current_exception();
+			}
+		});
+
+		// merge ranges in order, section is stored when the next one starts like in sequential parsing
+		config cfg(params.index);
+		link_resolver links;
+		section *last_section = nullptr;
+		for (auto &rng : ranges) {
+			for (auto &sect : rng.sections) {
+				if (last_section != nullptr) {
+					cfg.add_section(std::move(*last_section));
+				}
+				last_section = &sect;
+			}
+			if (rng.error) {
+				std::rethrow_exception(rng.error);
+			}
+			for (auto &link : rng.links) {
+				links.add(*link.opt, std::move(link.values), link.line_number);
+			}
+		}
+
+		if (last_section != nullptr) {
+			cfg.add_section(std::move(*last_section));
+		}
+
+		links.resolve([&cfg](const std::string &name) { return std::as_const(cfg).find(name); }, 0, links.size());
+
+		return cfg;
+	}
+}
@@ -0,0 +1,64 @@
+#ifndef INICPP_PARALLEL_LOADER_H
+#define INICPP_PARALLEL_LOADER_H
+
+#include <string_view>
+#include <vector>
+
+#include "config.h"
+#include "parser.h"
+
+namespace inicpp
+{
+	/**
+	 * Loader which parses contiguous buffer on multiple threads. Input is split
+	 * to ranges at lines which start a section, ranges are parsed concurrently
+	 * and merged in document order afterwards. Links to options are the only
+	 * dependency between sections, so they are collected by workers and
+	 * resolved after the merge. Result and reported errors are the same
+	 * as in case of sequential loading.
+	 */
+	class parallel_loader
+	{
+	private:
+		/** Minimal size of the range parsed by one thread */
+		static const size_t min_range_size = 64 * 1024;
+
+		struct link_entry;
+		struct range;
+		class range_builder;
+
+		/**
+		 * Split given text to at most @a count ranges. Every range except the first one
+		 * starts with a line which opens a section.
+		 * @param str whole input
+		 * @param count requested number of ranges
+		 * @return start positions of ranges followed by length of the input
+		 */
+		static std::vector<size_t> split(std::string_view str, size_t count);
+
+	public:
+		/**
+		 * Deleted default constructor.
+		 */
+		parallel_loader() = delete;
+
+		/**
+		 * Number of threads which should be used for given input.
+		 * @param str whole input
+		 * @param params loading parameters
+		 * @return number of threads, 1 if sequential loading should be used
+		 */
+		static size_t thread_count(std::string_view str, const load_params &params);
+		/**
+		 * Load ini configuration from given buffer using given number of threads.
+		 * @param str ini configuration description
+		 * @param threads number of threads
+		 * @param params loading parameters
+		 * @return newly created config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load(std::string_view str, size_t threads, const load_params &params);
+	};
+}
+
+#endif // INICPP_PARALLEL_LOADER_H
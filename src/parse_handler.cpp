@@ -0,0 +1,26 @@
+#include "parse_handler.h"
+
+namespace inicpp
+{
+	void parse_handler::on_section(std::string_view)
+	{
+	}
+
+	void parse_handler::on_option(std::string_view, std::vector<std::string> &)
+	{
+	}
+
+	void parse_handler::on_comment(std::string_view)
+	{
+	}
+
+	void parse_handler::on_error(const std::string &message, size_t)
+	{
+		throw parser_exception(message);
+	}
+
+	size_t parse_handler::get_line_number() const
+	{
+		return line_number_;
+	}
+}
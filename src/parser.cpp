@@ -1,8 +1,15 @@
 #include "parser.h"
+#include "file_writer.h"
+#include "mapped_file.h"
+#include "parallel_loader.h"
+#include "scanner.h"
+#include "serializer.h"
+
+#include <cstring>
 
 namespace inicpp
 {
-	size_t parser::find_first_nonescaped(const std::string &str, char ch)
+	size_t parser::find_first_nonescaped(std::string_view str, char ch)
 	{
 		size_t result = std::string::npos;
 		bool escaped = false;
@@ -24,365 +31,464 @@ namespace inicpp
 		return result;
 	}
 
-	size_t parser::find_last_escaped(const std::string &str, char ch)
+	std::string_view parser::unescape(std::string_view str, std::string &buffer)
 	{
-		size_t result = std::string::npos;
-		bool escaped = false;
-
-		for (size_t i = 0; i < str.length(); ++i) {
-			if (escaped) {
-				// escaped character, do not do anything
-				escaped = false;
-
-				if (str[i] == ch) {
-					result = i;
-				}
-			} else if (str[i] == '\\') {
-				// next character will be escaped
-				escaped = true;
-			}
+		size_t pos = str.find('\\');
+		if (pos == std::string_view::npos) {
+			// nothing to unescape, original bytes can be used
+			return str;
 		}
 
-		return result;
-	}
-
-	std::string parser::unescape(const std::string &str)
-	{
-		std::string result = str;
+		buffer.reserve(str.length());
+		buffer.assign(str.data(), pos);
 		bool escaped = false;
-
-		auto it = result.begin();
-		while (it != result.end()) {
+		for (size_t i = pos; i < str.length(); ++i) {
 			if (escaped) {
 				// escaped character, it should remain in string
 				escaped = false;
-			} else if (*it == '\\') {
-				// next character will be escaped, so delete escaping character
+			} else if (str[i] == '\\') {
+				// next character will be escaped, so skip escaping character
 				escaped = true;
-				it = result.erase(it);
 				continue;
 			}
-
-			// we have while cycle so we have to do this manually
-			++it;
+			buffer.push_back(str[i]);
 		}
 
-		return result;
+		return buffer;
 	}
 
-	std::string parser::delete_comment(const std::string &str)
-	{
-		return str.substr(0, find_first_nonescaped(str, ';'));
-	}
-
-	std::vector<std::string> parser::parse_option_list(const std::string &str)
+	void parser::parse_option_list(scanner &sc, size_t begin, size_t end, std::vector<std::string> &result)
 	{
 		using namespace string_utils;
 
-		std::string searched = str;
-		std::vector<std::string> result;
-		char delim = ',';
+		std::string_view text = sc.text();
 
-		size_t pos = find_first_nonescaped(searched, ',');
-		if (pos == std::string::npos) {
-			// if no escaped strokes are present in given string,
-			//   try to use colon
-			delim = ':';
+		// if no nonescaped commas are present in given string, try to use colon
+		scan_class delim = scan_class::comma;
+		size_t delim_count = sc.count(scan_class::comma, begin, end);
+		if (delim_count == 0) {
+			delim = scan_class::colon;
+			delim_count = sc.count(scan_class::colon, begin, end);
 		}
+		result.reserve(result.size() + delim_count + 1);
 
+		// every character is visited a constant number of times, so long lists are split in linear time
 		while (true) {
-			pos = find_first_nonescaped(searched, delim);
+			size_t pos = sc.find(delim, begin, end);
+			size_t item_end = (pos == scanner::npos ? end : pos);
 
 			// extract option value and process it
-			std::string value = searched.substr(0, pos);
-			value = left_trim(value);
-			// check if last escaped character is whitespace
-			size_t whitespace_pos = find_last_escaped(value, ' ');
-			value = right_trim(value);
-			if (whitespace_pos != std::string::npos) {
-				// last character is escaped whitespace
-				if (value.size() == whitespace_pos) {
-					value.push_back(' ');
-				}
+			std::string_view value = left_trim_view(text.substr(begin, item_end - begin));
+			std::string_view trimmed = right_trim_view(value);
+			// if escaped whitespace was trimmed, return it back
+			size_t trimmed_end = item_end - value.length() + trimmed.length();
+			if (trimmed_end < item_end && text[trimmed_end] == ' ' && sc.is_escaped(trimmed_end)) {
+				trimmed = value.substr(0, trimmed.length() + 1);
 			}
-			// finally unescape
-			value = unescape(value);
 
-			// save extracted and processed option value and cut searched string
-			result.push_back(value);
+			// finally unescape extracted option value right into the list, this is the only copy made
+			std::string &item = result.emplace_back();
+			std::string_view unescaped = unescape(trimmed, item);
+			if (unescaped.data() != item.data()) {
+				item.assign(unescaped);
+			}
 
-			if (pos == std::string::npos) {
+			if (pos == scanner::npos) {
 				// no delimiter found
 				break;
 			}
-			searched = searched.substr(pos + 1);
+			begin = pos + 1;
 		}
-
-		return result;
 	}
 
-	void parser::handle_links(
-		const config &cfg, const section &last_section, std::vector<std::string> &option_val_list, size_t line_number)
+	bool parser::is_link(std::string_view value)
 	{
-		using namespace string_utils;
-
-		for (auto &opt_value : option_val_list) {
-			if (starts_with(opt_value, "${") && ends_with(opt_value, "}")) {
-				std::string link = opt_value.substr(2, opt_value.length() - 3);
-				size_t delim = find_first_nonescaped(link, '#');
-
-				// link always has to be in format "section#option"
-				// section and option cannot be empty
-				if (delim == std::string::npos || (delim + 1) == link.length()) {
-					throw parser_exception("Bad format of link on line " + std::to_string(line_number));
-				}
+		return value.length() >= 3 && value.compare(0, 2, "${") == 0 && value.back() == '}';
+	}
 
-				std::string sect_link = link.substr(0, delim);
-				std::string opt_link = link.substr(delim + 1);
+	const char *parser::split_link(std::string_view value, std::string_view &sect_link, std::string_view &opt_link)
+	{
+		std::string_view link = value.substr(2, value.length() - 3);
+		size_t delim = find_first_nonescaped(link, '#');
 
-				if (sect_link.empty()) {
-					throw parser_exception(
-						"Section name in link cannot be empty on line " + std::to_string(line_number));
-				}
+		// link always has to be in format "section#option"
+		// section and option cannot be empty
+		if (delim == std::string::npos || (delim + 1) == link.length()) {
+			return "Bad format of link";
+		}
 
-				// find section with name specifid in link
-				const section *selected_section = nullptr;
-				if (last_section.get_name() == sect_link) {
-					selected_section = &last_section;
-				} else if (cfg.contains(sect_link)) {
-					selected_section = &cfg[sect_link];
-				} else {
-					throw parser_exception("Bad link on line " + std::to_string(line_number));
-				}
+		sect_link = link.substr(0, delim);
+		opt_link = link.substr(delim + 1);
 
-				// from selected section take appropriate option and set its value to options list
-				if (selected_section->contains(opt_link)) {
-					opt_value = selected_section->operator[](opt_link).get<string_ini_t>();
-				} else {
-					throw parser_exception("Option name in link not found on line " + std::to_string(line_number));
-				}
-			}
+		if (sect_link.empty()) {
+			return "Section name in link cannot be empty";
 		}
+
+		return nullptr;
 	}
 
-	void parser::validate_identifier(const std::string &str, size_t line_number)
+	bool parser::starts_section(std::string_view line)
 	{
-		std::regex reg_expr("^[a-zA-Z.$:][-a-zA-Z0-9_~.:$ ]*$");
-		if (!std::regex_match(str, reg_expr)) {
-			throw parser_exception("Identifier contains forbidden characters on line " + std::to_string(line_number));
-		}
+		line = string_utils::left_trim_view(line);
+		return !line.empty() && line.front() == '[';
 	}
 
-	config parser::internal_load(std::istream &str)
+	void parser::parse_line(
+		scanner &sc, size_t begin, size_t end, parse_handler &handler, line_state &state, const load_params &params)
 	{
 		using namespace string_utils;
 
-		config cfg;
-		std::shared_ptr<section> last_section = nullptr;
-		std::string line;
-		size_t line_number = 0;
+		// lines of skipped section are not lexed at all
+		if (state.skipping && !starts_section(sc.text().substr(begin, end - begin))) {
+			return;
+		}
 
-		while (std::getline(str, line)) {
-			line_number++;
+		size_t line_number = handler.line_number_;
+		auto error = [&](const std::string &message) {
+			handler.on_error(message + " on line " + std::to_string(line_number), line_number);
+		};
 
-			// if there was comment delete it
-			line = delete_comment(line);
-			line = left_trim(line);
+		// if there was comment cut it off, it is reported after the line content
+		size_t comment = sc.find(scan_class::semicolon, begin, end);
+		size_t line_end = end;
+		if (comment != scanner::npos) {
+			end = comment;
+		}
+		std::string_view line = left_trim_view(sc.text().substr(begin, end - begin));
+		begin = end - line.length();
+		std::string buffer;
+
+		if (line.empty()) { // empty line
+		} else if (line.front() == '[') { // start of section
+			line = right_trim_view(line);
+			if (line.back() != ']') {
+				return error("Section not ended");
+			}
 
-			if (line.empty()) { // empty line
-				continue;
-			} else if (starts_with(line, "[")) { // start of section
-				line = right_trim(line);
-				if (ends_with(line, "]")) {
-					// empty section name cannot be present
-					if (line.length() == 2) {
-						throw parser_exception("Section name cannot be empty on line " + std::to_string(line_number));
-					}
-
-					// if there is cached section, save it
-					if (last_section != nullptr) {
-						cfg.add_section(*last_section);
-					}
-
-					// extract name and validate it and finally create section object
-					std::string sect_name = unescape(line.substr(1, line.length() - 2));
-					validate_identifier(sect_name, line_number);
-					last_section = std::make_shared<section>(sect_name);
-				} else {
-					throw parser_exception("Section not ended on line " + std::to_string(line_number));
-				}
-			} else { // option
-				size_t opt_delim = find_first_nonescaped(line, '=');
-				if (opt_delim == std::string::npos) {
-					throw parser_exception("Unknown element option expected on line " + std::to_string(line_number));
-				}
+			// empty section name cannot be present
+			if (line.length() <= 2) {
+				return error("Section name cannot be empty");
+			}
 
-				// if there is no opened section, option has no parent section
-				if (last_section == nullptr) {
-					throw parser_exception("Option not in section on line " + std::to_string(line_number));
-				}
+			// extract name and validate it
+			std::string_view sect_name = unescape(line.substr(1, line.length() - 2), buffer);
+			if (!params.identifiers.is_valid(sect_name)) {
+				return error("Identifier contains forbidden characters");
+			}
 
-				// equals character was right at the end of line, should not be
-				if ((opt_delim + 1) == line.length()) {
-					throw parser_exception("Option value cannot be empty on line " + std::to_string(line_number));
-				}
+			state.in_section = true;
+			state.skipping = !params.selected.contains_section(sect_name);
+			if (state.skipping) {
+				return;
+			}
+			if (params.selected.filters_options()) {
+				state.section_name = sect_name;
+			}
+			handler.on_section(sect_name);
+		} else { // option
+			size_t opt_delim = sc.find(scan_class::equals, begin, end);
+			if (opt_delim == scanner::npos) {
+				return error("Unknown element option expected");
+			}
 
-				// retrieve option name and value from line
-				std::string option_name = unescape(trim(line.substr(0, opt_delim)));
-				std::string option_val = line.substr(opt_delim + 1);
+			// if there is no opened section, option has no parent section
+			if (!state.in_section) {
+				return error("Option not in section");
+			}
 
-				// validate option name
-				validate_identifier(option_name, line_number);
+			// equals character was right at the end of line, should not be
+			if ((opt_delim + 1) == end) {
+				return error("Option value cannot be empty");
+			}
 
-				if (option_name.empty()) {
-					throw parser_exception("Option name cannot be empty on line " + std::to_string(line_number));
-				}
+			// retrieve option name from line and validate it
+			std::string_view option_name = unescape(trim_view(line.substr(0, opt_delim - begin)), buffer);
+			if (!params.identifiers.is_valid(option_name)) {
+				return error("Identifier contains forbidden characters");
+			}
 
-				auto option_val_list = parse_option_list(option_val);
-				if (option_val_list.empty()) {
-					throw parser_exception("Option value cannot be empty on line " + std::to_string(line_number));
-				}
+			// not selected option is skipped before its values are split
+			if (!params.selected.contains_option(state.section_name, option_name)) {
+				return;
+			}
 
-				handle_links(cfg, *last_section, option_val_list, line_number);
+			auto &values = state.values;
+			values.clear();
+			parse_option_list(sc, opt_delim + 1, end, values);
 
-				// and finally create option and store it in current section
-				option opt(option_name, option_val_list);
-				last_section->add_option(opt);
+			// links are resolved by the handler, but their format is a matter of lexer
+			for (auto &value : values) {
+				std::string_view sect_link, opt_link;
+				const char *link_error = nullptr;
+				if (is_link(value) && (link_error = split_link(value, sect_link, opt_link)) != nullptr) {
+					return error(link_error);
+				}
 			}
-		}
 
-		// if there is cached section we have to add it to created config too
-		if (last_section != nullptr) {
-			cfg.add_section(*last_section);
+			handler.on_option(option_name, values);
 		}
 
-		return cfg;
+		if (comment != scanner::npos) {
+			handler.on_comment(trim_view(sc.text().substr(comment + 1, line_end - comment - 1)));
+		}
 	}
 
-	void parser::internal_save(const config &cfg, const schema &schm, std::ostream &str)
+	void parser::internal_parse(
+		std::string_view str, parse_handler &handler, const load_params &params, size_t line_offset)
 	{
-		for (auto &sect : cfg) {
-			bool contains = schm.contains(sect.get_name());
-			if (!contains) {
-				// write section which is not in schema
-				// if this happens we can safely write all section and its option to output
-				// we do not have to go through them and write their additional info
-				str << sect;
-				continue;
+		line_state state;
+		scanner sc;
+		sc.reset(str);
+		handler.line_number_ = line_offset;
+
+		size_t begin = 0;
+		while (begin < str.length()) {
+			handler.line_number_++;
+
+			// lines of skipped section are only searched for start of the next section
+			if (state.skipping) {
+				const void *newline = std::memchr(str.data() + begin, '\n', str.length() - begin);
+				size_t line_end =
+					(newline == nullptr ? str.length() : static_cast<const char *>(newline) - str.data());
+				if (!starts_section(str.substr(begin, line_end - begin))) {
+					begin = line_end + 1;
+					continue;
+				}
+				sc.seek(begin);
 			}
 
-			// if schema contains section from config, write additional info and name first
-			auto &sect_schema = schm[sect.get_name()];
-			sect_schema.write_additional_info(str);
-			sect_schema.write_section_name(str);
+			// lines are only slices of given buffer, nothing is copied
+			size_t line_end = sc.find(scan_class::newline, begin, str.length());
+			if (line_end == scanner::npos) {
+				line_end = str.length();
+			}
+			parse_line(sc, begin, line_end, handler, state, params);
 
-			// go through options and write them to output with info from option_schema
-			for (auto &opt : sect) {
-				if (sect_schema.contains(opt.get_name())) {
-					// if option is in section_schema, then write additional info
-					sect_schema[opt.get_name()].write_additional_info(str);
-				}
+			begin = line_end + 1;
+			sc.release(begin);
+		}
+	}
 
-				// write option name and value to output
-				str << opt;
-			}
+	void parser::internal_parse(std::istream &str, parse_handler &handler, const load_params &params)
+	{
+		line_state state;
+		std::string line;
+		scanner sc;
+		handler.line_number_ = 0;
 
-			// get through option_schema in appropriate section_schema
-			for (size_t i = 0; i < sect_schema.size(); ++i) {
-				auto &opt_schema = sect_schema[i];
-				if (sect.contains(opt_schema.get_name())) {
-					// already written to output stream
-					continue;
-				}
+		// line buffer is reused, so allocation is made only if longer line is encountered
+		while (std::getline(str, line)) {
+			handler.line_number_++;
+			sc.reset(line);
+			parse_line(sc, 0, line.length(), handler, state, params);
+		}
+	}
 
-				// option with this name does not exist in config,
-				//   so write its option_schema interpretation
-				str << opt_schema;
+	config parser::internal_load(
+		std::string_view str, const schema *schm, schema_mode mode, const load_params &params)
+	{
+		size_t threads = parallel_loader::thread_count(str, params);
+		if (threads > 1) {
+			config cfg = parallel_loader::load(str, threads, params);
+			if (schm != nullptr) {
+				cfg.validate(*schm, mode);
 			}
+			return cfg;
 		}
+
+		auto builder = (schm == nullptr ? config_builder(params.index) : config_builder(*schm, mode, params.index));
+		internal_parse(str, builder, params);
+		return builder.build();
 	}
 
-	config parser::load(const std::string &str)
+	config parser::internal_load(std::istream &str, const schema *schm, schema_mode mode, const load_params &params)
 	{
-		std::istringstream input(str);
-		return internal_load(input);
+		auto builder = (schm == nullptr ? config_builder(params.index) : config_builder(*schm, mode, params.index));
+		internal_parse(str, builder, params);
+		return builder.build();
 	}
 
-	config parser::load(const std::string &str, const schema &schm, schema_mode mode)
+	config parser::load(std::string_view str, const load_params &params)
 	{
-		std::istringstream input(str);
-		config cfg = internal_load(input);
-		cfg.validate(schm, mode);
-		return cfg;
+		return internal_load(str, nullptr, schema_mode::relaxed, params);
 	}
 
-	config parser::load(std::istream &str)
+	config parser::load(std::string_view str, const schema &schm, schema_mode mode, const load_params &params)
 	{
-		return internal_load(str);
+		return internal_load(str, &schm, mode, params);
 	}
 
-	config parser::load(std::istream &str, const schema &schm, schema_mode mode)
+	config parser::load(std::istream &str, const load_params &params)
 	{
-		config cfg = internal_load(str);
-		cfg.validate(schm, mode);
-		return cfg;
+		return internal_load(str, nullptr, schema_mode::relaxed, params);
 	}
 
-	config parser::load_file(const std::string &file)
+	config parser::load(std::istream &str, const schema &schm, schema_mode mode, const load_params &params)
 	{
+		return internal_load(str, &schm, mode, params);
+	}
+
+	config parser::load_file(const std::string &file, const load_params &params)
+	{
+		return load_file(file, nullptr, schema_mode::relaxed, params);
+	}
+
+	config parser::load_file(
+		const std::string &file, const schema &schm, schema_mode mode, const load_params &params)
+	{
+		return load_file(file, &schm, mode, params);
+	}
+
+	config parser::load_file(const std::string &file, const schema *schm, schema_mode mode, const load_params &params)
+	{
+		mapped_file mapping(file);
+		if (mapping.is_mapped()) {
+			// parse straight from the mapped pages
+			return internal_load(mapping.data(), schm, mode, params);
+		}
+
+		// pipes and special files cannot be mapped, read them as a stream
 		std::ifstream input(file);
 		if (input.fail()) {
 			throw parser_exception("File reading error");
 		}
 
-		return internal_load(input);
+		return internal_load(input, schm, mode, params);
+	}
+
+	config parser::load(std::string_view str, const selection &sel, const load_params &params)
+	{
+		load_params selected_params = params;
+		selected_params.selected = sel;
+		return internal_load(str, nullptr, schema_mode::relaxed, selected_params);
+	}
+
+	config parser::load(std::istream &str, const selection &sel, const load_params &params)
+	{
+		load_params selected_params = params;
+		selected_params.selected = sel;
+		return internal_load(str, nullptr, schema_mode::relaxed, selected_params);
+	}
+
+	config parser::load_file(const std::string &file, const selection &sel, const load_params &params)
+	{
+		load_params selected_params = params;
+		selected_params.selected = sel;
+		return load_file(file, nullptr, schema_mode::relaxed, selected_params);
+	}
+
+	lazy_config parser::load_lazy(std::string str, const load_params &params)
+	{
+		lazy_config cfg(params);
+		cfg.buffer_ = std::move(str);
+		cfg.build_index(nullptr, schema_mode::relaxed);
+		return cfg;
+	}
+
+	lazy_config parser::load_lazy(std::string str, const schema &schm, schema_mode mode, const load_params &params)
+	{
+		lazy_config cfg(params);
+		cfg.buffer_ = std::move(str);
+		cfg.build_index(&schm, mode);
+		return cfg;
+	}
+
+	lazy_config parser::load_file_lazy(const std::string &file, const load_params &params)
+	{
+		return load_file_lazy(file, nullptr, schema_mode::relaxed, params);
+	}
+
+	lazy_config parser::load_file_lazy(
+		const std::string &file, const schema &schm, schema_mode mode, const load_params &params)
+	{
+		return load_file_lazy(file, &schm, mode, params);
+	}
+
+	lazy_config parser::load_file_lazy(
+		const std::string &file, const schema *schm, schema_mode mode, const load_params &params)
+	{
+		lazy_config cfg(params);
+
+		mapped_file mapping(file);
+		if (mapping.is_mapped()) {
+			cfg.mapping_ = std::make_shared<mapped_file>(std::move(mapping));
+		} else {
+			std::ifstream input(file);
+			if (input.fail()) {
+				throw parser_exception("File reading error");
+			}
+			cfg.buffer_.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+		}
+
+		cfg.build_index(schm, mode);
+		return cfg;
 	}
 
-	config parser::load_file(const std::string &file, const schema &schm, schema_mode mode)
+	void parser::parse(std::string_view str, parse_handler &handler, const load_params &params)
 	{
+		internal_parse(str, handler, params);
+	}
+
+	void parser::parse(std::istream &str, parse_handler &handler, const load_params &params)
+	{
+		internal_parse(str, handler, params);
+	}
+
+	void parser::parse_file(const std::string &file, parse_handler &handler, const load_params &params)
+	{
+		mapped_file mapping(file);
+		if (mapping.is_mapped()) {
+			internal_parse(mapping.data(), handler, params);
+			return;
+		}
+
 		std::ifstream input(file);
 		if (input.fail()) {
 			throw parser_exception("File reading error");
 		}
 
-		config cfg = internal_load(input);
-		cfg.validate(schm, mode);
-		return cfg;
+		internal_parse(input, handler, params);
 	}
 
-	void parser::save(const config &cfg, const std::string &file)
+	void parser::save(const config &cfg, const std::string &file, const save_params &params)
 	{
-		std::ofstream output(file);
-		output << cfg;
-		output.close();
+		file_writer writer(file, params);
+		writer.output().write(cfg);
+		writer.commit();
 	}
 
 	void parser::save(const config &cfg, std::ostream &str)
 	{
-		str << cfg;
+		serializer output(str);
+		output.write(cfg);
+		output.flush();
 	}
 
-	void parser::save(const config &cfg, const schema &schm, const std::string &file)
+	void parser::save(const config &cfg, const schema &schm, const std::string &file, const save_params &params)
 	{
-		std::ofstream output(file);
-		internal_save(cfg, schm, output);
-		output.close();
+		file_writer writer(file, params);
+		writer.output().write(cfg, schm);
+		writer.commit();
 	}
 
 	void parser::save(const config &cfg, const schema &schm, std::ostream &str)
 	{
-		internal_save(cfg, schm, str);
+		serializer output(str);
+		output.write(cfg, schm);
+		output.flush();
 	}
 
-	void parser::save(const schema &schm, const std::string &file)
+	void parser::save(const schema &schm, const std::string &file, const save_params &params)
 	{
-		std::ofstream output(file);
-		output << schm;
-		output.close();
+		file_writer writer(file, params);
+		writer.output().write(schm);
+		writer.commit();
 	}
 
 	void parser::save(const schema &schm, std::ostream &str)
 	{
-		str << schm;
+		serializer output(str);
+		output.write(schm);
+		output.flush();
 	}
 }
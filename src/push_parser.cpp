@@ -0,0 +1,81 @@
+#include "push_parser.h"
+#include "scanner.h"
+
+#include <cstring>
+
+namespace inicpp
+{
+	push_parser::push_parser(parse_handler &handler, const load_params &params)
+		: handler_(handler), params_(params), scanner_(std::make_unique<scanner>()), line_number_(0)
+	{
+	}
+
+	push_parser::~push_parser()
+	{
+	}
+
+	void push_parser::parse_line(std::string_view line)
+	{
+		scanner_->reset(line);
+		handler_.line_number_ = ++line_number_;
+		parser::parse_line(*scanner_, 0, line.length(), handler_, state_, params_);
+	}
+
+	size_t push_parser::parse_lines(std::string_view text)
+	{
+		scanner &sc = *scanner_;
+		sc.reset(text);
+
+		// lines are parsed directly from the chunk, nothing is copied
+		size_t begin = 0;
+		while (true) {
+			size_t line_end = sc.find(scan_class::newline, begin, text.length());
+			if (line_end == scanner::npos) {
+				return begin;
+			}
+
+			handler_.line_number_ = ++line_number_;
+			parser::parse_line(sc, begin, line_end, handler_, state_, params_);
+
+			begin = line_end + 1;
+			sc.release(begin);
+		}
+	}
+
+	void push_parser::feed(const char *data, size_t size)
+	{
+		std::string_view chunk(data, size);
+
+		// newline is never escaped, so lines can be completed without lexing
+		if (!pending_.empty()) {
+			const void *newline = std::memchr(data, '\n', size);
+			if (newline == nullptr) {
+				pending_.append(chunk);
+				return;
+			}
+
+			size_t line_end = static_cast<const char *>(newline) - data;
+			pending_.append(chunk.substr(0, line_end));
+			chunk.remove_prefix(line_end + 1);
+			// line is taken out first, so it is not glued to the next chunk if parsing throws
+			std::string line = std::move(pending_);
+			pending_.clear();
+			parse_line(line);
+		}
+
+		size_t rest = parse_lines(chunk);
+		pending_.append(chunk.substr(rest));
+	}
+
+	void push_parser::finish()
+	{
+		std::string line = std::move(pending_);
+		pending_.clear();
+		if (!line.empty()) {
+			parse_line(line);
+		}
+
+		state_ = parser::line_state();
+		line_number_ = 0;
+	}
+}
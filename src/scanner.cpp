@@ -0,0 +1,344 @@
+#include "scanner.h"
+
+#include "exception.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INICPP_SCANNER_X86
+#define INICPP_SCANNER_DISPATCH
+#define INICPP_TARGET(name) __attribute__((target(name)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define INICPP_SCANNER_X86
+#define INICPP_TARGET(name)
+#include <emmintrin.h>
+#include <intrin.h>
+#endif
+
+namespace inicpp
+{
+	namespace
+	{
+		/** Type of functions which classify one block */
+		using block_classifier = void (*)(const char *, raw_scan_block &);
+
+		size_t count_trailing_zeros(uint64_t value)
+		{
+#if defined(__GNUC__)
+			return static_cast<size_t>(__builtin_ctzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanForward64(&index, value);
+			return index;
+#else
+			size_t result = 0;
+			while (!(value & 1)) {
+				value >>= 1;
+				++result;
+			}
+			return result;
+#endif
+		}
+
+		size_t count_ones(uint64_t value)
+		{
+#if defined(__GNUC__)
+			return static_cast<size_t>(__builtin_popcountll(value));
+#else
+			size_t result = 0;
+			for (; value != 0; value &= value - 1) {
+				++result;
+			}
+			return result;
+#endif
+		}
+
+		/**
+		 * Compute positions of escaped characters from positions of backslashes.
+		 * Backslashes are rare in ini files, so only set bits are visited.
+		 * @param backslash mask of backslashes in the block
+		 * @param carry in: first character is escaped, out: first character of next block is escaped
+		 * @return mask of escaped characters
+		 */
+		uint64_t resolve_escapes(uint64_t backslash, bool &carry)
+		{
+			uint64_t escaped = 0;
+			if (carry) {
+				// first character is escaped by the last backslash of previous block
+				escaped |= 1;
+				backslash &= ~static_cast<uint64_t>(1);
+				carry = false;
+			}
+
+			while (backslash != 0) {
+				size_t pos = count_trailing_zeros(backslash);
+				if (pos == scanner::block_size - 1) {
+					carry = true;
+					break;
+				}
+
+				// following character is escaped, if it is backslash, it does not escape anything
+				escaped |= static_cast<uint64_t>(1) << (pos + 1);
+				backslash &= ~(static_cast<uint64_t>(3) << pos);
+			}
+
+			return escaped;
+		}
+
+#ifdef INICPP_SCANNER_X86
+		INICPP_TARGET("sse2") inline uint64_t equal_mask_sse2(__m128i chunk, char ch)
+		{
+			return static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(ch))));
+		}
+
+		INICPP_TARGET("sse2") void classify_sse2(const char *data, raw_scan_block &block)
+		{
+			block = raw_scan_block();
+			for (size_t i = 0; i < scanner::block_size; i += 16) {
+				__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+				block.newline |= equal_mask_sse2(chunk, '\n') << i;
+				block.equals |= equal_mask_sse2(chunk, '=') << i;
+				block.semicolon |= equal_mask_sse2(chunk, ';') << i;
+				block.comma |= equal_mask_sse2(chunk, ',') << i;
+				block.colon |= equal_mask_sse2(chunk, ':') << i;
+				block.backslash |= equal_mask_sse2(chunk, '\\') << i;
+			}
+		}
+#endif
+
+#ifdef INICPP_SCANNER_DISPATCH
+		INICPP_TARGET("avx2") inline uint64_t equal_mask_avx2(__m256i chunk, char ch)
+		{
+			return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(ch))));
+		}
+
+		INICPP_TARGET("avx2") void classify_avx2(const char *data, raw_scan_block &block)
+		{
+			block = raw_scan_block();
+			for (size_t i = 0; i < scanner::block_size; i += 32) {
+				__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+				block.newline |= equal_mask_avx2(chunk, '\n') << i;
+				block.equals |= equal_mask_avx2(chunk, '=') << i;
+				block.semicolon |= equal_mask_avx2(chunk, ';') << i;
+				block.comma |= equal_mask_avx2(chunk, ',') << i;
+				block.colon |= equal_mask_avx2(chunk, ':') << i;
+				block.backslash |= equal_mask_avx2(chunk, '\\') << i;
+			}
+		}
+#endif
+
+		/**
+		 * Select best classifier for running processor.
+		 */
+		block_classifier select_classifier()
+		{
+#ifdef INICPP_SCANNER_DISPATCH
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2")) {
+				return classify_avx2;
+			}
+			if (__builtin_cpu_supports("sse2")) {
+				return classify_sse2;
+			}
+#elif defined(INICPP_SCANNER_X86)
+			// SSE2 is part of x86-64 baseline
+			return classify_sse2;
+#endif
+			return scanner::classify_scalar;
+		}
+	} // anonymous namespace
+
+
+	scanner::scanner() : base_(0), carry_(false)
+	{
+	}
+
+	void scanner::reset(std::string_view text)
+	{
+		text_ = text;
+		blocks_.clear();
+		base_ = 0;
+		carry_ = false;
+	}
+
+	std::string_view scanner::text() const
+	{
+		return text_;
+	}
+
+	const scan_block &scanner::ensure(size_t pos)
+	{
+		size_t index = pos / block_size;
+		while (base_ + blocks_.size() <= index) {
+			size_t offset = (base_ + blocks_.size()) * block_size;
+			raw_scan_block raw;
+			if (offset + block_size <= text_.size()) {
+				classify(text_.data() + offset, raw);
+			} else {
+				// last block is shorter, pad it with zeros which do not belong to any class
+				char padded[block_size] = {};
+				std::memcpy(padded, text_.data() + offset, text_.size() - offset);
+				classify(padded, raw);
+			}
+
+			uint64_t escaped = resolve_escapes(raw.backslash, carry_);
+			scan_block block;
+			// escaped newline still ends the line
+			block.masks[static_cast<size_t>(scan_class::newline)] = raw.newline;
+			block.masks[static_cast<size_t>(scan_class::equals)] = raw.equals & ~escaped;
+			block.masks[static_cast<size_t>(scan_class::semicolon)] = raw.semicolon & ~escaped;
+			block.masks[static_cast<size_t>(scan_class::comma)] = raw.comma & ~escaped;
+			block.masks[static_cast<size_t>(scan_class::colon)] = raw.colon & ~escaped;
+			block.masks[static_cast<size_t>(scan_class::escaped)] = escaped;
+			blocks_.push_back(block);
+		}
+
+		return blocks_[index - base_];
+	}
+
+	size_t scanner::find(scan_class cls, size_t from, size_t to)
+	{
+		if (from >= to) {
+			return npos;
+		}
+
+		size_t first = from / block_size;
+		size_t last = (to - 1) / block_size;
+		for (size_t index = first; index <= last; ++index) {
+			uint64_t mask = ensure(index * block_size).masks[static_cast<size_t>(cls)];
+			if (index == first) {
+				mask &= ~static_cast<uint64_t>(0) << (from % block_size);
+			}
+			if (index == last) {
+				size_t bits = (to - 1) % block_size + 1;
+				if (bits < block_size) {
+					mask &= (static_cast<uint64_t>(1) << bits) - 1;
+				}
+			}
+
+			if (mask != 0) {
+				return index * block_size + count_trailing_zeros(mask);
+			}
+		}
+
+		return npos;
+	}
+
+	size_t scanner::count(scan_class cls, size_t from, size_t to)
+	{
+		if (from >= to) {
+			return 0;
+		}
+
+		size_t result = 0;
+		size_t first = from / block_size;
+		size_t last = (to - 1) / block_size;
+		for (size_t index = first; index <= last; ++index) {
+			uint64_t mask = ensure(index * block_size).masks[static_cast<size_t>(cls)];
+			if (index == first) {
+				mask &= ~static_cast<uint64_t>(0) << (from % block_size);
+			}
+			if (index == last) {
+				size_t bits = (to - 1) % block_size + 1;
+				if (bits < block_size) {
+					mask &= (static_cast<uint64_t>(1) << bits) - 1;
+				}
+			}
+			result += count_ones(mask);
+		}
+
+		return result;
+	}
+
+	bool scanner::is_escaped(size_t pos)
+	{
+		uint64_t mask = ensure(pos).masks[static_cast<size_t>(scan_class::escaped)];
+		return (mask >> (pos % block_size)) & 1;
+	}
+
+	void scanner::release(size_t pos)
+	{
+		size_t index = pos / block_size;
+		if (index <= base_) {
+			return;
+		}
+
+		// only already classified blocks can be dropped, escaping carry belongs to the next one
+		size_t drop = std::min(index - base_, blocks_.size());
+		blocks_.erase(blocks_.begin(), blocks_.begin() + drop);
+		base_ += drop;
+	}
+
+	void scanner::seek(size_t pos)
+	{
+		size_t index = pos / block_size;
+		if (index < base_ + blocks_.size()) {
+			release(pos);
+			return;
+		}
+
+		// characters of skipped line in the first block are classified too, but preceding
+		// newline ends any chain of backslashes, so escaping of following characters is right
+		blocks_.clear();
+		base_ = index;
+		carry_ = false;
+	}
+
+	void scanner::classify(const char *data, raw_scan_block &block)
+	{
+		static const block_classifier best = select_classifier();
+		best(data, block);
+	}
+
+	void scanner::classify_scalar(const char *data, raw_scan_block &block)
+	{
+		block = raw_scan_block();
+		for (size_t i = 0; i < block_size; ++i) {
+			uint64_t bit = static_cast<uint64_t>(1) << i;
+			switch (data[i]) {
+			case '\n': block.newline |= bit; break;
+			case '=': block.equals |= bit; break;
+			case ';': block.semicolon |= bit; break;
+			case ',': block.comma |= bit; break;
+			case ':': block.colon |= bit; break;
+			case '\\': block.backslash |= bit; break;
+			default: break;
+			}
+		}
+	}
+
+	std::vector<std::string> scanner::available_classifiers()
+	{
+		std::vector<std::string> result = {"scalar"};
+#ifdef INICPP_SCANNER_DISPATCH
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("sse2")) {
+			result.push_back("sse2");
+		}
+		if (__builtin_cpu_supports("avx2")) {
+			result.push_back("avx2");
+		}
+#elif defined(INICPP_SCANNER_X86)
+		result.push_back("sse2");
+#endif
+		return result;
+	}
+
+	void scanner::classify_with(const std::string &name, const char *data, raw_scan_block &block)
+	{
+		if (name == "scalar") {
+			classify_scalar(data, block);
+#ifdef INICPP_SCANNER_X86
+		} else if (name == "sse2") {
+			classify_sse2(data, block);
+#endif
+#ifdef INICPP_SCANNER_DISPATCH
+		} else if (name == "avx2") {
+			classify_avx2(data, block);
+#endif
+		} else {
+			throw not_found_exception(name);
+		}
+	}
+}
@@ -0,0 +1,157 @@
+#ifndef INICPP_SCANNER_H
+#define INICPP_SCANNER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inicpp
+{
+	/**
+	 * Classes of characters which are recognized by the scanner.
+	 * Values are used as indexes to mask arrays.
+	 */
+	enum class scan_class : unsigned char { newline, equals, semicolon, comma, colon, escaped, count };
+
+	/**
+	 * Bitmasks of one block of input. Bit i of each mask corresponds to i-th byte of the block.
+	 */
+	struct scan_block {
+		/** Masks indexed by scan_class */
+		uint64_t masks[static_cast<size_t>(scan_class::count)];
+	};
+
+	/**
+	 * Raw classification of one block of input, before escaping is resolved.
+	 */
+	struct raw_scan_block {
+		/** Positions of '\n' */
+		uint64_t newline;
+		/** Positions of '=' */
+		uint64_t equals;
+		/** Positions of ';' */
+		uint64_t semicolon;
+		/** Positions of ',' */
+		uint64_t comma;
+		/** Positions of ':' */
+		uint64_t colon;
+		/** Positions of '\' */
+		uint64_t backslash;
+	};
+
+	/**
+	 * Lexer helper which classifies structural characters of the input in blocks
+	 * of 64 bytes with one vectorized pass. Parser then finds delimiters and comments
+	 * by reading the bitmasks instead of rescanning the text. Escaped characters
+	 * are excluded from all masks except the newline one, escaping state is carried
+	 * between blocks. Only blocks of currently processed line are kept in memory.
+	 */
+	class scanner
+	{
+	private:
+		/** Scanned text */
+		std::string_view text_;
+		/** Classified blocks, first one has index base_ */
+		std::vector<scan_block> blocks_;
+		/** Index of first block stored in blocks_ */
+		size_t base_;
+		/** True if first character of next unclassified block is escaped */
+		bool carry_;
+
+		/**
+		 * Classify all blocks up to the one containing given position.
+		 * @param pos position in scanned text
+		 * @return classified block containing @a pos
+		 */
+		const scan_block &ensure(size_t pos);
+
+	public:
+		/** Size of one block in bytes */
+		static constexpr size_t block_size = 64;
+		/** Returned if nothing was found */
+		static constexpr size_t npos = std::string_view::npos;
+
+		/**
+		 * Construct scanner with empty input.
+		 */
+		scanner();
+
+		/**
+		 * Start scanning of new text, previous state is dropped.
+		 * @param text scanned text which has to live while it is scanned
+		 */
+		void reset(std::string_view text);
+		/**
+		 * Scanned text.
+		 * @return view given to reset()
+		 */
+		std::string_view text() const;
+
+		/**
+		 * Finds first character of given class in given range of the text.
+		 * Escaped characters are skipped with exception of newlines.
+		 * @param cls class of searched character
+		 * @param from start of searched range
+		 * @param to end of searched range (exclusive)
+		 * @return position of the character or npos if not found
+		 */
+		size_t find(scan_class cls, size_t from, size_t to);
+		/**
+		 * Counts characters of given class in given range of the text.
+		 * Escaped characters are skipped with exception of newlines.
+		 * @param cls class of counted characters
+		 * @param from start of counted range
+		 * @param to end of counted range (exclusive)
+		 * @return number of characters
+		 */
+		size_t count(scan_class cls, size_t from, size_t to);
+		/**
+		 * Determines if character on given position is escaped by backslash.
+		 * @param pos position in the text
+		 * @return true if character is escaped
+		 */
+		bool is_escaped(size_t pos);
+		/**
+		 * Informs scanner that positions before given one will not be queried
+		 * anymore, so their blocks can be freed.
+		 * @param pos position from which scanning continues
+		 */
+		void release(size_t pos);
+		/**
+		 * Continue scanning at the start of given line, text before it is not classified.
+		 * Escaping cannot continue over newline, so no state is needed from skipped text.
+		 * @param pos position which directly follows newline character or zero
+		 */
+		void seek(size_t pos);
+
+		/**
+		 * Classify one block of exactly block_size bytes with the best
+		 * implementation supported by running processor.
+		 * @param data start of the block
+		 * @param block output masks
+		 */
+		static void classify(const char *data, raw_scan_block &block);
+		/**
+		 * Portable implementation of classify().
+		 * @param data start of the block
+		 * @param block output masks
+		 */
+		static void classify_scalar(const char *data, raw_scan_block &block);
+		/**
+		 * Names of block classifiers usable on running processor,
+		 * scalar one is always present.
+		 * @return list of implementation names
+		 */
+		static std::vector<std::string> available_classifiers();
+		/**
+		 * Classify block with named implementation, used for testing.
+		 * @param name name of implementation from available_classifiers()
+		 * @param data start of the block
+		 * @param block output masks
+		 */
+		static void classify_with(const std::string &name, const char *data, raw_scan_block &block);
+	};
+}
+
+#endif // INICPP_SCANNER_H
@@ -1,4 +1,7 @@
 #include "schema.h"
+#include "serializer.h"
+
+#include <utility>
 
 namespace inicpp
 {
@@ -30,12 +33,12 @@ namespace inicpp
 		return *this;
 	}
 
-	schema::schema(schema &&source)
+	schema::schema(schema &&source) noexcept
+		: sections_(std::move(source.sections_)), sections_map_(std::move(source.sections_map_))
 	{
-		*this = std::move(source);
 	}
 
-	schema &schema::operator=(schema &&source)
+	schema &schema::operator=(schema &&source) noexcept
 	{
 		if (this != &source) {
 			sections_ = std::move(source.sections_);
@@ -57,6 +60,18 @@ namespace inicpp
 		}
 	}
 
+	void schema::add_section(section_schema &&sect_schema)
+	{
+		auto add_it = sections_map_.find(sect_schema.get_name());
+		if (add_it == sections_map_.end()) {
+			std::shared_ptr<section_schema> add = std::make_shared<section_schema>(std::move(sect_schema));
+			sections_.push_back(add);
+			sections_map_.insert(sect_schema_map_pair(add->get_name(), add));
+		} else {
+			throw ambiguity_exception(sect_schema.get_name());
+		}
+	}
+
 	void schema::add_section(const section_schema_params &arguments)
 	{
 		auto add_it = sections_map_.find(arguments.name);
@@ -79,6 +94,16 @@ namespace inicpp
 		}
 	}
 
+	void schema::add_option(const std::string &section_name, option_schema &&opt_schema)
+	{
+		auto sect_it = sections_map_.find(section_name);
+		if (sect_it != sections_map_.end()) {
+			sect_it->second->add_option(std::move(opt_schema));
+		} else {
+			throw not_found_exception(section_name);
+		}
+	}
+
 	size_t schema::size() const
 	{
 		return sections_.size();
@@ -102,36 +127,39 @@ namespace inicpp
 		return *sections_[index];
 	}
 
-	section_schema &schema::operator[](const std::string &section_name)
+	section_schema &schema::operator[](std::string_view section_name)
 	{
-		std::shared_ptr<section_schema> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(section_name);
+		auto result = find(section_name);
+		if (result == nullptr) {
+			throw not_found_exception(std::string(section_name));
 		}
 		return *result;
 	}
 
-	const section_schema &schema::operator[](const std::string &section_name) const
+	const section_schema &schema::operator[](std::string_view section_name) const
 	{
-		std::shared_ptr<section_schema> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(section_name);
+		auto result = find(section_name);
+		if (result == nullptr) {
+			throw not_found_exception(std::string(section_name));
 		}
 		return *result;
 	}
 
-	bool schema::contains(const std::string &section_name) const
+	bool schema::contains(std::string_view section_name) const
 	{
-		try {
-			sections_map_.at(section_name);
-			return true;
-		} catch (std::out_of_range) {
-			return false;
-		}
+		return find(section_name) != nullptr;
+	}
+
+	section_schema *schema::find(std::string_view section_name)
+	{
+		auto it = sections_map_.find(section_name);
+		return (it == sections_map_.end() ? nullptr : it->second.get());
+	}
+
+	const section_schema *schema::find(std::string_view section_name) const
+	{
+		auto it = sections_map_.find(section_name);
+		return (it == sections_map_.end() ? nullptr : it->second.get());
 	}
 
 	void schema::validate_config(config &cfg, schema_mode mode) const
@@ -150,7 +178,7 @@ namespace inicpp
 
 			if (contains) {
 				// even if section is not mandatory, we execute validation of section (both modes)
-				sect->validate_section(cfg[sect->get_name()], mode);
+				sect->validate_section(cfg.unshared_section(sect->get_name()), mode);
 			} else if (sect->is_mandatory()) {
 				// mandatory section is not present in given config (both modes)
 				throw validation_exception("Mandatory section '" + sect->get_name() + "' is missing in config");
@@ -166,7 +194,7 @@ namespace inicpp
 		}
 
 		// secondly go through sections
-		for (auto &sect : cfg) {
+		for (auto &sect : std::as_const(cfg)) {
 			bool contains = this->contains(sect.get_name());
 
 			// if schema contains section everything is fine, we handled this above
@@ -181,12 +209,14 @@ namespace inicpp
 		}
 	}
 
-	std::ostream &operator<<(std::ostream &os, const schema &schm)
+	compiled_schema schema::compile() const
 	{
-		for (auto &sect : schm.sections_) {
-			os << *sect;
-		}
+		return compiled_schema(*this);
+	}
 
+	std::ostream &operator<<(std::ostream &os, const schema &schm)
+	{
+		serializer(os).write(schm);
 		return os;
 	}
 }
@@ -1,18 +1,21 @@
 #include "section.h"
+#include "serializer.h"
+
+#include <atomic>
 
 namespace inicpp
 {
-	section::section(const section &source) : name_(source.name_)
+	section::section(const section &source)
+		: index_(source.index_), exposed_(source.exposed_.size(), false), name_(source.name_)
 	{
-		// we have to do deep copies of options
 		options_.reserve(source.options_.size());
-		for (auto &opt : source.options_) {
-			options_.push_back(std::make_shared<option>(*opt));
-		}
-
-		// we already have constructed options... now push them into map
-		for (auto &opt : options_) {
-			options_map_.insert(options_map_pair(opt->get_name(), opt));
+		for (size_t i = 0; i < source.options_.size(); ++i) {
+			// references to exposed option can modify it, so the copy gets its own clone
+			if (source.exposed_[i]) {
+				options_.push_back(std::make_shared<option>(*source.options_[i]));
+			} else {
+				options_.push_back(source.options_[i]);
+			}
 		}
 	}
 
@@ -27,22 +30,41 @@ namespace inicpp
 		return *this;
 	}
 
-	section::section(section &&source)
+	section::section(section &&source) noexcept
+		: options_(std::move(source.options_)), index_(std::move(source.index_)),
+		  exposed_(std::move(source.exposed_)), name_(std::move(source.name_))
 	{
-		operator=(std::move(source));
 	}
 
-	section &section::operator=(section &&source)
+	section &section::operator=(section &&source) noexcept
 	{
 		if (this != &source) {
 			options_ = std::move(source.options_);
-			options_map_ = std::move(source.options_map_);
+			index_ = std::move(source.index_);
+			exposed_ = std::move(source.exposed_);
 			name_ = std::move(source.name_);
 		}
 		return *this;
 	}
 
-	section::section(const std::string &name) : name_(name)
+	option &section::unshared_option(size_t position)
+	{
+		std::shared_ptr<option> &opt = options_[position];
+		// the same reasoning as in config::unshared_section()
+		if (opt.use_count() > 1) {
+			opt = std::make_shared<option>(*opt);
+		} else {
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		return *opt;
+	}
+
+	bool section::has_exposed_options() const
+	{
+		return std::find(exposed_.begin(), exposed_.end(), true) != exposed_.end();
+	}
+
+	section::section(const std::string &name, index_policy policy) : index_(policy), name_(name)
 	{
 	}
 
@@ -53,11 +75,21 @@ namespace inicpp
 
 	void section::add_option(const option &opt)
 	{
-		auto add_it = options_map_.find(opt.get_name());
-		if (add_it == options_map_.end()) {
-			std::shared_ptr<option> add = std::make_shared<option>(opt);
-			options_.push_back(add);
-			options_map_.insert(options_map_pair(add->get_name(), add));
+		if (!contains(opt.get_name())) {
+			options_.push_back(std::make_shared<option>(opt));
+			index_.push_back(options_);
+			exposed_.push_back(false);
+		} else {
+			throw ambiguity_exception(opt.get_name());
+		}
+	}
+
+	void section::add_option(option &&opt)
+	{
+		if (!contains(opt.get_name())) {
+			options_.push_back(std::make_shared<option>(std::move(opt)));
+			index_.push_back(options_);
+			exposed_.push_back(false);
 		} else {
 			throw ambiguity_exception(opt.get_name());
 		}
@@ -65,16 +97,11 @@ namespace inicpp
 
 	void section::remove_option(const std::string &option_name)
 	{
-		auto del_it = options_map_.find(option_name);
-		if (del_it != options_map_.end()) {
-			// remove from map
-			options_map_.erase(del_it);
-			// remove from vector
-			options_.erase(
-				std::remove_if(options_.begin(),
-					options_.end(),
-					[&](std::shared_ptr<option> opt) { return (opt->get_name() == option_name ? true : false); }),
-				options_.end());
+		size_t position = index_.find(option_name, options_);
+		if (position != index_.npos) {
+			options_.erase(options_.begin() + position);
+			exposed_.erase(exposed_.begin() + position);
+			index_.erase(option_name, position, options_);
 		} else {
 			throw not_found_exception(option_name);
 		}
@@ -87,11 +114,7 @@ namespace inicpp
 
 	option &section::operator[](size_t index)
 	{
-		if (index >= size()) {
-			throw not_found_exception(index);
-		}
-
-		return *options_[index];
+		return mutable_option(index);
 	}
 
 	const option &section::operator[](size_t index) const
@@ -103,36 +126,55 @@ namespace inicpp
 		return *options_[index];
 	}
 
-	option &section::operator[](const std::string &option_name)
+	option &section::operator[](std::string_view option_name)
 	{
-		std::shared_ptr<option> result;
-		try {
-			result = options_map_.at(option_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(option_name);
+		return mutable_option(option_name);
+	}
+
+	const option &section::operator[](std::string_view option_name) const
+	{
+		auto result = find(option_name);
+		if (result == nullptr) {
+			throw not_found_exception(std::string(option_name));
 		}
 		return *result;
 	}
 
-	const option &section::operator[](const std::string &option_name) const
+	bool section::contains(std::string_view option_name) const
 	{
-		std::shared_ptr<option> result;
-		try {
-			result = options_map_.at(option_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(option_name);
+		return find(option_name) != nullptr;
+	}
+
+	option *section::find(std::string_view option_name)
+	{
+		size_t position = index_.find(option_name, options_);
+		return (position == index_.npos ? nullptr : &mutable_option(position));
+	}
+
+	const option *section::find(std::string_view option_name) const
+	{
+		size_t position = index_.find(option_name, options_);
+		return (position == index_.npos ? nullptr : options_[position].get());
+	}
+
+	option &section::mutable_option(size_t index)
+	{
+		if (index >= size()) {
+			throw not_found_exception(index);
 		}
-		return *result;
+
+		option &result = unshared_option(index);
+		exposed_[index] = true;
+		return result;
 	}
 
-	bool section::contains(const std::string &option_name) const
+	option &section::mutable_option(std::string_view option_name)
 	{
-		try {
-			options_map_.at(option_name);
-			return true;
-		} catch (std::out_of_range) {
-			return false;
+		size_t position = index_.find(option_name, options_);
+		if (position == index_.npos) {
+			throw not_found_exception(std::string(option_name));
 		}
+		return mutable_option(position);
 	}
 
 	void section::validate(const section_schema &sect_schema, schema_mode mode)
@@ -171,31 +213,27 @@ namespace inicpp
 
 	section::const_iterator section::begin() const
 	{
-		return const_iterator(const_cast<section &>(*this));
+		return const_iterator(*this);
 	}
 
 	section::const_iterator section::end() const
 	{
-		return const_iterator(const_cast<section &>(*this), options_.size());
+		return const_iterator(*this, options_.size());
 	}
 
 	section::const_iterator section::cbegin() const
 	{
-		return const_iterator(const_cast<section &>(*this));
+		return const_iterator(*this);
 	}
 
 	section::const_iterator section::cend() const
 	{
-		return const_iterator(const_cast<section &>(*this), options_.size());
+		return const_iterator(*this, options_.size());
 	}
 
 	std::ostream &operator<<(std::ostream &os, const section &sect)
 	{
-		os << "[" << sect.get_name() << "]" << std::endl;
-		for (auto &opt : sect.options_) {
-			os << *opt;
-		}
-
+		serializer(os).write(sect);
 		return os;
 	}
 }
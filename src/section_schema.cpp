@@ -1,5 +1,7 @@
 #include "section_schema.h"
-#include "string_utils.h"
+#include "serializer.h"
+
+#include <utility>
 
 namespace inicpp
 {
@@ -28,12 +30,13 @@ namespace inicpp
 		return *this;
 	}
 
-	section_schema::section_schema(section_schema &&source)
+	section_schema::section_schema(section_schema &&source) noexcept
+		: name_(std::move(source.name_)), requirement_(source.requirement_), comment_(std::move(source.comment_)),
+		  options_(std::move(source.options_)), options_map_(std::move(source.options_map_))
 	{
-		*this = std::move(source);
 	}
 
-	section_schema &section_schema::operator=(section_schema &&source)
+	section_schema &section_schema::operator=(section_schema &&source) noexcept
 	{
 		if (this != &source) {
 			name_ = std::move(source.name_);
@@ -78,6 +81,18 @@ namespace inicpp
 		}
 	}
 
+	void section_schema::add_option(option_schema &&opt)
+	{
+		auto add_it = options_map_.find(opt.get_name());
+		if (add_it == options_map_.end()) {
+			std::shared_ptr<option_schema> add = std::make_shared<option_schema>(std::move(opt));
+			options_.push_back(add);
+			options_map_.insert(opt_schema_map_pair(add->get_name(), add));
+		} else {
+			throw ambiguity_exception(opt.get_name());
+		}
+	}
+
 	void section_schema::remove_option(const std::string &option_name)
 	{
 		auto del_it = options_map_.find(option_name);
@@ -119,32 +134,37 @@ namespace inicpp
 		return *options_[index];
 	}
 
-	option_schema &section_schema::operator[](const std::string &option_name)
+	option_schema &section_schema::operator[](std::string_view option_name)
 	{
 		// its not pretty but the code is not copy pasted
 		// TODO: solve if it will be used or not
 		return const_cast<option_schema &>(static_cast<const section_schema *>(this)->operator[](option_name));
 	}
 
-	const option_schema &section_schema::operator[](const std::string &option_name) const
+	const option_schema &section_schema::operator[](std::string_view option_name) const
 	{
-		std::shared_ptr<option_schema> result;
-		try {
-			result = options_map_.at(option_name);
-		} catch (std::out_of_range) {
-			throw not_found_exception(option_name);
+		auto result = find(option_name);
+		if (result == nullptr) {
+			throw not_found_exception(std::string(option_name));
 		}
 		return *result;
 	}
 
-	bool section_schema::contains(const std::string &option_name) const
+	bool section_schema::contains(std::string_view option_name) const
 	{
-		try {
-			options_map_.at(option_name);
-			return true;
-		} catch (std::out_of_range) {
-			return false;
-		}
+		return find(option_name) != nullptr;
+	}
+
+	option_schema *section_schema::find(std::string_view option_name)
+	{
+		auto it = options_map_.find(option_name);
+		return (it == options_map_.end() ? nullptr : it->second.get());
+	}
+
+	const option_schema *section_schema::find(std::string_view option_name) const
+	{
+		auto it = options_map_.find(option_name);
+		return (it == options_map_.end() ? nullptr : it->second.get());
 	}
 
 	void section_schema::validate_section(section &sect, schema_mode mode) const
@@ -159,11 +179,11 @@ namespace inicpp
 
 		// firstly go through option schemas
 		for (auto &opt : options_) {
-			bool contains = sect.contains(opt->get_name());
+			size_t position = sect.index_.find(opt->get_name(), sect.options_);
 
-			if (contains) {
+			if (position != sect.index_.npos) {
 				// even if option is not mandatory, we execute validation of option (both modes)
-				opt->validate_option(sect[opt->get_name()]);
+				opt->validate_option(sect.unshared_option(position));
 			} else if (opt->is_mandatory()) {
 				// mandatory option is not present in given section (both modes)
 				throw validation_exception(
@@ -173,12 +193,12 @@ namespace inicpp
 				//   => add option with default value
 				sect.add_option(opt->get_name(), opt->get_default_value());
 				// validate added option, so type of the value could be changed to nonstring type
-				opt->validate_option(sect[opt->get_name()]);
+				opt->validate_option(sect.unshared_option(sect.size() - 1));
 			}
 		}
 
 		// secondly go through options
-		for (auto &opt : sect) {
+		for (auto &opt : std::as_const(sect)) {
 			bool contains = this->contains(opt.get_name());
 
 			// if section_schema contains option everything is fine, we handled this above
@@ -195,38 +215,19 @@ namespace inicpp
 
 	std::ostream &section_schema::write_additional_info(std::ostream &os) const
 	{
-		// write comment
-		auto comment_lines = string_utils::split(get_comment(), '\n');
-		for (auto &comment_line : comment_lines) {
-			os << ";" << comment_line << std::endl;
-		}
-
-		// optional/mandatory
-		std::string info_line = is_mandatory() ? "mandatory" : "optional";
-		os << ";<" << info_line << ">" << std::endl;
-
+		serializer(os).write_info(*this);
 		return os;
 	}
 
 	std::ostream &section_schema::write_section_name(std::ostream &os) const
 	{
-		os << "[" << get_name() << "]" << std::endl;
+		serializer(os).write_section_name(get_name());
 		return os;
 	}
 
 	std::ostream &operator<<(std::ostream &os, const section_schema &sect_schema)
 	{
-		// write additional information about given section
-		sect_schema.write_additional_info(os);
-
-		// write name
-		sect_schema.write_section_name(os);
-
-		// write all containing options
-		for (auto &opt : sect_schema.options_) {
-			os << *opt;
-		}
-
+		serializer(os).write(sect_schema);
 		return os;
 	}
 }
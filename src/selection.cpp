@@ -0,0 +1,67 @@
+#include "selection.h"
+
+#include <map>
+#include <memory>
+#include <set>
+
+namespace inicpp
+{
+	selection::selection() : sections_(nullptr), options_(nullptr)
+	{
+	}
+
+	selection::selection(std::initializer_list<std::string> section_names)
+		: selection(std::vector<std::string>(section_names))
+	{
+	}
+
+	selection::selection(const std::vector<std::string> &section_names) : options_(nullptr)
+	{
+		auto names = std::make_shared<std::set<std::string, std::less<>>>(section_names.begin(), section_names.end());
+		sections_ = [names](std::string_view section_name) { return names->find(section_name) != names->end(); };
+	}
+
+	selection::selection(section_predicate sections, option_predicate options)
+		: sections_(std::move(sections)), options_(std::move(options))
+	{
+	}
+
+	selection::selection(const schema &schm)
+	{
+		using options_set = std::set<std::string, std::less<>>;
+		auto names = std::make_shared<std::map<std::string, options_set, std::less<>>>();
+		for (size_t i = 0; i < schm.size(); ++i) {
+			auto &sect_schema = schm[i];
+			auto &options = (*names)[sect_schema.get_name()];
+			for (size_t j = 0; j < sect_schema.size(); ++j) {
+				options.insert(sect_schema[j].get_name());
+			}
+		}
+
+		sections_ = [names](std::string_view section_name) { return names->find(section_name) != names->end(); };
+		options_ = [names](std::string_view section_name, std::string_view option_name) {
+			auto sect_it = names->find(section_name);
+			return sect_it != names->end() && sect_it->second.find(option_name) != sect_it->second.end();
+		};
+	}
+
+	bool selection::selects_all() const
+	{
+		return sections_ == nullptr && options_ == nullptr;
+	}
+
+	bool selection::filters_options() const
+	{
+		return options_ != nullptr;
+	}
+
+	bool selection::contains_section(std::string_view section_name) const
+	{
+		return sections_ == nullptr || sections_(section_name);
+	}
+
+	bool selection::contains_option(std::string_view section_name, std::string_view option_name) const
+	{
+		return options_ == nullptr || options_(section_name, option_name);
+	}
+}
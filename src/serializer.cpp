@@ -0,0 +1,302 @@
+#include "serializer.h"
+#include "string_utils.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <io.h>
+#endif
+
+namespace inicpp
+{
+	namespace
+	{
+		/**
+		 * Append one value of an option to the output.
+		 */
+		void append_value(std::string &output, boolean_ini_t value)
+		{
+			output += (value ? "yes" : "no");
+		}
+		/**
+		 * Append one value of an option to the output.
+		 */
+		template <typename ValueType> void append_value(std::string &output, ValueType value)
+		{
+			char text[string_utils::max_formatted_length];
+			output.append(text, string_utils::format_value(value, text));
+		}
+
+		/**
+		 * Write whole buffer to file descriptor.
+		 * @param fd open file descriptor
+		 * @param data written data
+		 * @param size size of the data
+		 * @return true if all data were written
+		 */
+		bool write_fd(int fd, const char *data, size_t size)
+		{
+			while (size > 0) {
+#if defined(__unix__) || defined(__APPLE__)
+				ssize_t written = ::write(fd, data, size);
+#elif defined(_WIN32)
+				int written = ::_write(fd, data, static_cast<unsigned int>(std::min<size_t>(size, 1u << 30)));
+#else
+				int written = -1;
+#endif
+				if (written < 0 && errno == EINTR) {
+					continue;
+				}
+				if (written <= 0) {
+					return false;
+				}
+				data += written;
+				size -= static_cast<size_t>(written);
+			}
+			return true;
+		}
+	}
+
+	serializer::serializer(std::string &output) : string_(&output), stream_(nullptr), fd_(-1), capacity_(0)
+	{
+	}
+
+	serializer::serializer(std::ostream &output, size_t capacity)
+		: string_(nullptr), stream_(&output), fd_(-1), capacity_(capacity)
+	{
+	}
+
+	serializer::serializer(int fd, size_t capacity) : string_(nullptr), stream_(nullptr), fd_(fd), capacity_(capacity)
+	{
+	}
+
+	serializer::~serializer()
+	{
+		try {
+			flush();
+		} catch (...) {
+			// destructor cannot report errors, flush() has to be called explicitly for that
+		}
+	}
+
+	void serializer::flush()
+	{
+		if (buffer_.empty()) {
+			return;
+		}
+
+		bool ok = true;
+		if (stream_ != nullptr) {
+			ok = static_cast<bool>(stream_->write(buffer_.data(), buffer_.size()));
+		} else if (string_ == nullptr) {
+			// invalid descriptor is reported by write
+			ok = write_fd(fd_, buffer_.data(), buffer_.size());
+		}
+		// buffer keeps its capacity for next data
+		buffer_.clear();
+		if (!ok) {
+			throw parser_exception("File writing error");
+		}
+	}
+
+	void serializer::write_escaped(std::string_view value)
+	{
+		std::string &out = output();
+		if (value.empty()) {
+			return;
+		}
+		if (std::isspace(static_cast<unsigned char>(value.front()))) {
+			out += '\\';
+		}
+		if (value.length() > 1 && std::isspace(static_cast<unsigned char>(value.back()))) {
+			out.append(value.data(), value.length() - 1);
+			out += '\\';
+			out += value.back();
+		} else {
+			out.append(value.data(), value.length());
+		}
+	}
+
+	void serializer::write_values(const option &opt)
+	{
+		std::string &out = output();
+		std::visit(
+			[this, &out](const auto &values) {
+				for (size_t i = 0; i < values.size(); ++i) {
+					if (i > 0) {
+						out += ',';
+					}
+					using value_type = typename std::decay<decltype(values)>::type::value_type;
+					if constexpr (std::is_same<value_type, string_ini_t>::value) {
+						write_escaped(values[i]);
+					} else if constexpr (std::is_same<value_type, enum_ini_t>::value) {
+						write_escaped(static_cast<std::string>(values[i]));
+					} else {
+						append_value(out, values[i]);
+					}
+				}
+			},
+			opt.values_);
+	}
+
+	void serializer::write_comment(const std::string &comment)
+	{
+		// every line of the comment, except of empty last one, starts with semicolon
+		std::string &out = output();
+		size_t begin = 0;
+		while (begin < comment.length()) {
+			size_t end = comment.find('\n', begin);
+			if (end == std::string::npos) {
+				end = comment.length();
+			}
+			out += ';';
+			out.append(comment, begin, end - begin);
+			out += '\n';
+			begin = end + 1;
+		}
+	}
+
+	serializer &serializer::write(const option &opt)
+	{
+		std::string &out = output();
+		out += opt.get_name();
+		out += " = ";
+		write_values(opt);
+		out += '\n';
+		check_capacity();
+		return *this;
+	}
+
+	serializer &serializer::write(const section &sect)
+	{
+		write_section_name(sect.get_name());
+		for (auto &opt : sect) {
+			write(opt);
+		}
+		return *this;
+	}
+
+	serializer &serializer::write(const config &cfg)
+	{
+		for (auto &sect : cfg) {
+			write(sect);
+		}
+		return *this;
+	}
+
+	serializer &serializer::write(const option_schema &opt_schema)
+	{
+		write_info(opt_schema);
+
+		std::string &out = output();
+		out += opt_schema.get_name();
+		out += " = ";
+		out += opt_schema.get_default_value();
+		out += '\n';
+		check_capacity();
+		return *this;
+	}
+
+	serializer &serializer::write(const section_schema &sect_schema)
+	{
+		write_info(sect_schema);
+		write_section_name(sect_schema.get_name());
+		for (size_t i = 0; i < sect_schema.size(); ++i) {
+			write(sect_schema[i]);
+		}
+		return *this;
+	}
+
+	serializer &serializer::write(const schema &schm)
+	{
+		for (size_t i = 0; i < schm.size(); ++i) {
+			write(schm[i]);
+		}
+		return *this;
+	}
+
+	serializer &serializer::write(const config &cfg, const schema &schm)
+	{
+		for (auto &sect : cfg) {
+			auto sect_schema = schm.find(sect.get_name());
+			if (sect_schema == nullptr) {
+				// write section which is not in schema
+				// if this happens we can safely write all section and its option to output
+				// we do not have to go through them and write their additional info
+				write(sect);
+				continue;
+			}
+
+			// if schema contains section from config, write additional info and name first
+			write_info(*sect_schema);
+			write_section_name(sect.get_name());
+
+			// go through options and write them to output with info from option_schema
+			for (auto &opt : sect) {
+				auto opt_schema = sect_schema->find(opt.get_name());
+				if (opt_schema != nullptr) {
+					// if option is in section_schema, then write additional info
+					write_info(*opt_schema);
+				}
+
+				// write option name and value to output
+				write(opt);
+			}
+
+			// get through option_schema in appropriate section_schema
+			for (size_t i = 0; i < sect_schema->size(); ++i) {
+				auto &opt_schema = (*sect_schema)[i];
+				if (sect.contains(opt_schema.get_name())) {
+					// already written to output
+					continue;
+				}
+
+				// option with this name does not exist in config,
+				//   so write its option_schema interpretation
+				write(opt_schema);
+			}
+		}
+		return *this;
+	}
+
+	serializer &serializer::write_info(const option_schema &opt_schema)
+	{
+		write_comment(opt_schema.get_comment());
+
+		// optional/mandatory and single/list
+		std::string &out = output();
+		out += (opt_schema.is_mandatory() ? ";<mandatory, " : ";<optional, ");
+		out += (opt_schema.is_list() ? "list>\n" : "single>\n");
+
+		// default value given at construction
+		out += ";<default value: \"";
+		out += opt_schema.get_default_value();
+		out += "\">\n";
+		check_capacity();
+		return *this;
+	}
+
+	serializer &serializer::write_info(const section_schema &sect_schema)
+	{
+		write_comment(sect_schema.get_comment());
+
+		// optional/mandatory
+		output() += (sect_schema.is_mandatory() ? ";<mandatory>\n" : ";<optional>\n");
+		check_capacity();
+		return *this;
+	}
+
+	serializer &serializer::write_section_name(std::string_view name)
+	{
+		std::string &out = output();
+		out += '[';
+		out.append(name.data(), name.length());
+		out += "]\n";
+		check_capacity();
+		return *this;
+	}
+}
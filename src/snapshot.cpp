@@ -0,0 +1,500 @@
+#include "snapshot.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+namespace inicpp
+{
+	namespace
+	{
+		/** Magic bytes on the beginning of each snapshot */
+		const char snapshot_magic[8] = {'I', 'N', 'I', 'C', 'P', 'P', 'S', 'N'};
+		/** Current version of snapshot format */
+		const uint32_t snapshot_version = 1;
+		/** Byte order marker, reads differently on platform with other byte order */
+		const uint32_t byte_order_marker = 0x01020304;
+
+		/**
+		 * FNV-1a hash of given data.
+		 * @param data hashed bytes
+		 * @return 64 bit checksum
+		 */
+		uint64_t checksum(std::string_view data)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (unsigned char c : data) {
+				hash ^= c;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		/**
+		 * Round size up to multiple of eight, so all tables are aligned.
+		 * @param size size of a table
+		 * @return aligned size
+		 */
+		size_t align(size_t size)
+		{
+			return (size + 7) & ~static_cast<size_t>(7);
+		}
+
+		/**
+		 * Check that number fits into 32 bit field of snapshot.
+		 * @param value checked number
+		 * @return value as 32 bit integer
+		 * @throws parser_exception if number is too big
+		 */
+		uint32_t narrow(size_t value)
+		{
+			if (value > std::numeric_limits<uint32_t>::max()) {
+				throw parser_exception("Config is too large for snapshot");
+			}
+			return static_cast<uint32_t>(value);
+		}
+
+		/**
+		 * String table of written snapshot, same strings are stored only once.
+		 */
+		class string_table
+		{
+		private:
+			/** Offsets of already stored strings */
+			std::unordered_map<std::string, uint32_t> offsets_;
+
+		public:
+			/** Content of the table */
+			std::string data;
+
+			/**
+			 * Store string in the table.
+			 * @param str stored string
+			 * @return offset of the string
+			 */
+			uint32_t add(const std::string &str)
+			{
+				auto offset_it = offsets_.find(str);
+				if (offset_it != offsets_.end()) {
+					return offset_it->second;
+				}
+				uint32_t offset = narrow(data.size());
+				narrow(data.size() + str.size());
+				data += str;
+				offsets_.emplace(str, offset);
+				return offset;
+			}
+
+			/**
+			 * Store string and pack its offset and length into one value.
+			 * @param str stored string
+			 * @return offset in upper and length in lower half
+			 */
+			uint64_t add_value(const std::string &str)
+			{
+				uint64_t offset = add(str);
+				return (offset << 32) | narrow(str.size());
+			}
+		};
+
+		/**
+		 * Convert values of the option into raw values of snapshot.
+		 * @param opt option with at least one value
+		 * @param strings string table into which strings are stored
+		 * @param values array to which values are appended
+		 */
+		void add_values(const option &opt, string_table &strings, std::vector<uint64_t> &values)
+		{
+			switch (opt.get_type()) {
+			case option_type::boolean_e:
+				for (bool value : opt.get_list<boolean_ini_t>()) {
+					values.push_back(value ? 1 : 0);
+				}
+				break;
+			case option_type::signed_e:
+				for (signed_ini_t value : opt.get_list<signed_ini_t>()) {
+					values.push_back(static_cast<uint64_t>(value));
+				}
+				break;
+			case option_type::unsigned_e:
+				for (unsigned_ini_t value : opt.get_list<unsigned_ini_t>()) {
+					values.push_back(value);
+				}
+				break;
+			case option_type::float_e:
+				for (float_ini_t value : opt.get_list<float_ini_t>()) {
+					uint64_t bits;
+					std::memcpy(&bits, &value, sizeof(bits));
+					values.push_back(bits);
+				}
+				break;
+			case option_type::enum_e:
+				for (auto &value : opt.get_list<enum_ini_t>()) {
+					values.push_back(strings.add_value(value));
+				}
+				break;
+			case option_type::string_e:
+				for (auto &value : opt.get_list<string_ini_t>()) {
+					values.push_back(strings.add_value(value));
+				}
+				break;
+			case option_type::invalid_e:
+			default: throw invalid_type_exception("Invalid option type"); break;
+			}
+		}
+
+		/**
+		 * Copy table into snapshot data.
+		 * @param output snapshot data
+		 * @param offset offset of the table
+		 * @param table copied table
+		 */
+		template <typename Record> void copy_table(std::string &output, size_t offset, const std::vector<Record> &table)
+		{
+			if (!table.empty()) {
+				std::memcpy(&output[offset], table.data(), table.size() * sizeof(Record));
+			}
+		}
+	}
+
+
+	snapshot::snapshot() : header_()
+	{
+	}
+
+	snapshot::snapshot(snapshot &&source) noexcept = default;
+
+	snapshot &snapshot::operator=(snapshot &&source) noexcept = default;
+
+	snapshot::~snapshot()
+	{
+	}
+
+	std::string_view snapshot::data() const
+	{
+		if (mapping_ != nullptr) {
+			return mapping_->data();
+		}
+		return buffer_;
+	}
+
+	void snapshot::write(const config &cfg, std::ostream &output)
+	{
+		static_assert(sizeof(header) == 112, "Snapshot header has to be without padding");
+		static_assert(sizeof(option_record) == 24, "Option record has to be without padding");
+
+		string_table strings;
+		std::vector<section_record> sections;
+		std::vector<option_record> options;
+		std::vector<uint32_t> section_order;
+		std::vector<uint32_t> option_order;
+		std::vector<uint64_t> values;
+		std::vector<std::string_view> names;
+
+		for (size_t i = 0; i < cfg.size(); ++i) {
+			const section &sect = cfg[i];
+			uint32_t first_option = narrow(options.size());
+			for (size_t j = 0; j < sect.size(); ++j) {
+				const option &opt = sect[j];
+				uint32_t first_value = narrow(values.size());
+				if (opt.values_size() > 0) {
+					add_values(opt, strings, values);
+				}
+				options.push_back(option_record{strings.add(opt.get_name()),
+					narrow(opt.get_name().size()),
+					first_value,
+					narrow(values.size() - first_value),
+					static_cast<uint32_t>(opt.get_type()),
+					0});
+				names.push_back(opt.get_name());
+				option_order.push_back(narrow(options.size() - 1));
+			}
+
+			// options of each section are searched by their names
+			std::sort(option_order.begin() + first_option, option_order.end(), [&names](uint32_t lhs, uint32_t rhs) {
+				return names[lhs] < names[rhs];
+			});
+
+			sections.push_back(section_record{strings.add(sect.get_name()),
+				narrow(sect.get_name().size()),
+				first_option,
+				narrow(options.size() - first_option)});
+			section_order.push_back(narrow(sections.size() - 1));
+		}
+		std::sort(section_order.begin(), section_order.end(), [&cfg](uint32_t lhs, uint32_t rhs) {
+			return cfg[lhs].get_name() < cfg[rhs].get_name();
+		});
+
+		// lay out tables one after another, each of them aligned
+		header head;
+		std::memcpy(head.magic, snapshot_magic, sizeof(head.magic));
+		head.version = snapshot_version;
+		head.byte_order = byte_order_marker;
+		head.section_count = sections.size();
+		head.option_count = options.size();
+		head.value_count = values.size();
+		head.strings_size = strings.data.size();
+		head.sections_offset = sizeof(header);
+		head.section_order_offset = head.sections_offset + align(sections.size() * sizeof(section_record));
+		head.options_offset = head.section_order_offset + align(section_order.size() * sizeof(uint32_t));
+		head.option_order_offset = head.options_offset + align(options.size() * sizeof(option_record));
+		head.values_offset = head.option_order_offset + align(option_order.size() * sizeof(uint32_t));
+		head.strings_offset = head.values_offset + values.size() * sizeof(uint64_t);
+		head.file_size = head.strings_offset + strings.data.size();
+
+		std::string data(head.file_size, '\0');
+		copy_table(data, head.sections_offset, sections);
+		copy_table(data, head.section_order_offset, section_order);
+		copy_table(data, head.options_offset, options);
+		copy_table(data, head.option_order_offset, option_order);
+		copy_table(data, head.values_offset, values);
+		data.replace(head.strings_offset, strings.data.size(), strings.data);
+
+		head.checksum = checksum(std::string_view(data).substr(sizeof(header)));
+		std::memcpy(&data[0], &head, sizeof(header));
+		output.write(data.data(), data.size());
+	}
+
+	void snapshot::write_file(const config &cfg, const std::string &file)
+	{
+		std::ofstream output(file, std::ios::binary);
+		if (output.fail()) {
+			throw parser_exception("File writing error");
+		}
+		write(cfg, output);
+		output.close();
+		if (output.fail()) {
+			throw parser_exception("File writing error");
+		}
+	}
+
+	snapshot snapshot::load(std::string data, bool verify_checksum)
+	{
+		snapshot snap;
+		snap.buffer_ = std::move(data);
+		snap.check(verify_checksum);
+		return snap;
+	}
+
+	snapshot snapshot::open(const std::string &file, bool verify_checksum)
+	{
+		snapshot snap;
+		auto mapping = std::make_shared<mapped_file>(file);
+		if (mapping->is_mapped()) {
+			snap.mapping_ = std::move(mapping);
+		} else {
+			std::ifstream input(file, std::ios::binary);
+			if (input.fail()) {
+				throw parser_exception("File reading error");
+			}
+			snap.buffer_.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+		}
+		snap.check(verify_checksum);
+		return snap;
+	}
+
+	void snapshot::check(bool verify_checksum)
+	{
+		std::string_view str = data();
+		if (str.size() < sizeof(header)) {
+			throw parser_exception("Snapshot is too short");
+		}
+		std::memcpy(&header_, str.data(), sizeof(header));
+
+		if (std::memcmp(header_.magic, snapshot_magic, sizeof(snapshot_magic)) != 0) {
+			throw parser_exception("File is not a snapshot");
+		}
+		if (header_.version != snapshot_version) {
+			throw parser_exception("Unsupported snapshot version " + std::to_string(header_.version));
+		}
+		if (header_.byte_order != byte_order_marker) {
+			throw parser_exception("Snapshot was written on platform with different byte order");
+		}
+		if (header_.file_size != str.size()) {
+			throw parser_exception("Snapshot is truncated");
+		}
+
+		// all tables have to be inside of the data, counts are limited to avoid overflows
+		auto inside = [&str](uint64_t offset, uint64_t count, size_t record_size) {
+			return count <= std::numeric_limits<uint32_t>::max() && offset <= str.size() &&
+				count * record_size <= str.size() - offset;
+		};
+		if (!inside(header_.sections_offset, header_.section_count, sizeof(section_record)) ||
+			!inside(header_.section_order_offset, header_.section_count, sizeof(uint32_t)) ||
+			!inside(header_.options_offset, header_.option_count, sizeof(option_record)) ||
+			!inside(header_.option_order_offset, header_.option_count, sizeof(uint32_t)) ||
+			!inside(header_.values_offset, header_.value_count, sizeof(uint64_t)) ||
+			!inside(header_.strings_offset, header_.strings_size, 1)) {
+			throw parser_exception("Snapshot tables are out of range");
+		}
+
+		if (verify_checksum && checksum(str.substr(sizeof(header))) != header_.checksum) {
+			throw parser_exception("Snapshot checksum mismatch");
+		}
+	}
+
+	std::string_view snapshot::string_at(uint32_t offset, uint32_t length) const
+	{
+		if (static_cast<uint64_t>(offset) + length > header_.strings_size) {
+			throw parser_exception("Snapshot string is out of range");
+		}
+		return data().substr(header_.strings_offset + offset, length);
+	}
+
+	size_t snapshot::find_section(std::string_view section_name) const
+	{
+		size_t low = 0;
+		size_t high = header_.section_count;
+		while (low < high) {
+			size_t middle = low + (high - low) / 2;
+			uint32_t index = read<uint32_t>(header_.section_order_offset, middle);
+			if (index >= header_.section_count) {
+				throw parser_exception("Snapshot section is out of range");
+			}
+			section_record record = read<section_record>(header_.sections_offset, index);
+			std::string_view name = string_at(record.name_offset, record.name_length);
+			if (name == section_name) {
+				return index;
+			} else if (name < section_name) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+		return std::string::npos;
+	}
+
+	size_t snapshot::find_option(std::string_view section_name, std::string_view option_name) const
+	{
+		size_t section_index = find_section(section_name);
+		if (section_index == std::string::npos) {
+			return std::string::npos;
+		}
+
+		section_record sect = read<section_record>(header_.sections_offset, section_index);
+		if (static_cast<uint64_t>(sect.first_option) + sect.option_count > header_.option_count) {
+			throw parser_exception("Snapshot option is out of range");
+		}
+
+		size_t low = sect.first_option;
+		size_t high = low + sect.option_count;
+		while (low < high) {
+			size_t middle = low + (high - low) / 2;
+			uint32_t index = read<uint32_t>(header_.option_order_offset, middle);
+			if (index >= header_.option_count) {
+				throw parser_exception("Snapshot option is out of range");
+			}
+			option_record record = read<option_record>(header_.options_offset, index);
+			std::string_view name = string_at(record.name_offset, record.name_length);
+			if (name == option_name) {
+				if (static_cast<uint64_t>(record.first_value) + record.value_count > header_.value_count) {
+					throw parser_exception("Snapshot value is out of range");
+				}
+				return index;
+			} else if (name < option_name) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+		return std::string::npos;
+	}
+
+	snapshot::option_record snapshot::get_option(std::string_view section_name, std::string_view option_name) const
+	{
+		size_t index = find_option(section_name, option_name);
+		if (index == std::string::npos) {
+			throw not_found_exception(std::string(contains(section_name) ? option_name : section_name));
+		}
+		return read<option_record>(header_.options_offset, index);
+	}
+
+	uint64_t snapshot::raw_value(const option_record &record, size_t index) const
+	{
+		if (index >= record.value_count) {
+			throw not_found_exception(index);
+		}
+		return read<uint64_t>(header_.values_offset, record.first_value + index);
+	}
+
+	std::string_view snapshot::string_value(const option_record &record, size_t index) const
+	{
+		uint64_t bits = raw_value(record, index);
+		return string_at(static_cast<uint32_t>(bits >> 32), static_cast<uint32_t>(bits));
+	}
+
+	size_t snapshot::size() const
+	{
+		return header_.section_count;
+	}
+
+	std::string_view snapshot::section_name(size_t index) const
+	{
+		if (index >= header_.section_count) {
+			throw not_found_exception(index);
+		}
+		section_record record = read<section_record>(header_.sections_offset, index);
+		return string_at(record.name_offset, record.name_length);
+	}
+
+	bool snapshot::contains(std::string_view section_name) const
+	{
+		return find_section(section_name) != std::string::npos;
+	}
+
+	bool snapshot::contains(std::string_view section_name, std::string_view option_name) const
+	{
+		return find_option(section_name, option_name) != std::string::npos;
+	}
+
+	option_type snapshot::get_type(std::string_view section_name, std::string_view option_name) const
+	{
+		return static_cast<option_type>(get_option(section_name, option_name).type);
+	}
+
+	std::string_view snapshot::get_view(std::string_view section_name, std::string_view option_name, size_t index) const
+	{
+		option_record record = get_option(section_name, option_name);
+		option_type type = static_cast<option_type>(record.type);
+		if (type != option_type::string_e && type != option_type::enum_e) {
+			throw bad_cast_exception("Cannot cast to requested type");
+		}
+		return string_value(record, index);
+	}
+
+	config snapshot::to_config() const
+	{
+		config cfg;
+		for (size_t i = 0; i < header_.section_count; ++i) {
+			section_record sect_record = read<section_record>(header_.sections_offset, i);
+			if (static_cast<uint64_t>(sect_record.first_option) + sect_record.option_count > header_.option_count) {
+				throw parser_exception("Snapshot option is out of range");
+			}
+
+			section sect(std::string(string_at(sect_record.name_offset, sect_record.name_length)));
+			for (size_t j = sect_record.first_option; j < sect_record.first_option + sect_record.option_count; ++j) {
+				option_record record = read<option_record>(header_.options_offset, j);
+				if (static_cast<uint64_t>(record.first_value) + record.value_count > header_.value_count) {
+					throw parser_exception("Snapshot value is out of range");
+				}
+
+				option opt(std::string(string_at(record.name_offset, record.name_length)));
+				switch (static_cast<option_type>(record.type)) {
+				case option_type::boolean_e: opt.set_list(read_values<boolean_ini_t>(record)); break;
+				case option_type::signed_e: opt.set_list(read_values<signed_ini_t>(record)); break;
+				case option_type::unsigned_e: opt.set_list(read_values<unsigned_ini_t>(record)); break;
+				case option_type::float_e: opt.set_list(read_values<float_ini_t>(record)); break;
+				case option_type::enum_e: opt.set_list(read_values<enum_ini_t>(record)); break;
+				case option_type::string_e: opt.set_list(read_values<string_ini_t>(record)); break;
+				case option_type::invalid_e:
+				default: throw parser_exception("Snapshot option has invalid type"); break;
+				}
+				sect.add_option(std::move(opt));
+			}
+			cfg.add_section(std::move(sect));
+		}
+		return cfg;
+	}
+}
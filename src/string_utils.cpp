@@ -1,6 +1,8 @@
 #include "string_utils.h"
 #include "exception.h"
 #include <algorithm>
+#include <charconv>
+#include <limits>
 #include <string>
 
 namespace inicpp
@@ -30,6 +32,25 @@ namespace inicpp
 			return std::string(front, back);
 		}
 
+		std::string_view left_trim_view(std::string_view str)
+		{
+			auto front = std::find_if(str.begin(), str.end(), [](unsigned char c) { return !std::isspace(c); });
+			str.remove_prefix(front - str.begin());
+			return str;
+		}
+
+		std::string_view right_trim_view(std::string_view str)
+		{
+			auto back = std::find_if(str.rbegin(), str.rend(), [](unsigned char c) { return !std::isspace(c); });
+			str.remove_suffix(back - str.rbegin());
+			return str;
+		}
+
+		std::string_view trim_view(std::string_view str)
+		{
+			return right_trim_view(left_trim_view(str));
+		}
+
 		bool find_needle(const std::string &haystack, const std::string &needle)
 		{
 			return (haystack.find(needle) == std::string::npos ? false : true);
@@ -83,22 +104,225 @@ namespace inicpp
 		}
 
 
+		namespace
+		{
+			/**
+			 * Boolean keyword in perfect hash table.
+			 */
+			struct boolean_keyword {
+				/** Keyword, empty for unused slot */
+				std::string_view name;
+				/** Value of the keyword */
+				bool value;
+			};
+
+			/**
+			 * All boolean keywords on positions given by boolean_hash().
+			 */
+			const boolean_keyword boolean_keywords[16] = {{"on", true},
+				{"t", true},
+				{"yes", true},
+				{"f", false},
+				{"", false},
+				{"off", false},
+				{"1", true},
+				{"enabled", true},
+				{"", false},
+				{"no", false},
+				{"", false},
+				{"n", false},
+				{"disabled", false},
+				{"0", false},
+				{"y", true},
+				{"", false}};
+
+			/**
+			 * Hash which has no collisions for boolean keywords.
+			 * @param str non-empty text
+			 * @return index to boolean_keywords table
+			 */
+			size_t boolean_hash(std::string_view str)
+			{
+				auto first = static_cast<unsigned char>(str.front());
+				auto last = static_cast<unsigned char>(str.back());
+				return (first * 8 + last + str.length() * 13) & 15;
+			}
+
+			/**
+			 * Parse optional sign on the beginning of the text.
+			 * @param str parsed text, sign is removed from it
+			 * @return true if number is negative
+			 */
+			bool parse_sign(std::string_view &str)
+			{
+				bool negative = !str.empty() && str.front() == '-';
+				if (!str.empty() && (str.front() == '-' || str.front() == '+')) {
+					str.remove_prefix(1);
+				}
+				return negative;
+			}
+
+			/**
+			 * Parse magnitude of integer with base given by its prefix.
+			 * @param str parsed text without sign
+			 * @param value parsed magnitude
+			 * @return ok, invalid or out_of_range
+			 */
+			parse_status parse_magnitude(std::string_view str, uint64_t &value)
+			{
+				int base = 10;
+				if (str.length() > 1 && str[0] == '0') {
+					if (str[1] == 'x' || str[1] == 'X') {
+						base = 16;
+						str.remove_prefix(2);
+					} else if (str[1] == 'b' || str[1] == 'B') {
+						base = 2;
+						str.remove_prefix(2);
+					} else {
+						base = 8;
+						str.remove_prefix(1);
+					}
+				}
+
+				// from_chars accepts no sign, so only digits can follow the prefix
+				uint64_t result;
+				auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.length(), result, base);
+				if (str.empty() || ptr != str.data() + str.length()) {
+					return parse_status::invalid;
+				}
+				if (ec == std::errc::result_out_of_range) {
+					return parse_status::out_of_range;
+				}
+				if (ec != std::errc()) {
+					return parse_status::invalid;
+				}
+				value = result;
+				return parse_status::ok;
+			}
+
+			/**
+			 * Throw exception describing failed parsing.
+			 * @param status reason of failure
+			 * @param value parsed text
+			 * @param option_name name of the parsed option
+			 * @param type_name name of the requested type
+			 * @throws invalid_type_exception allways
+			 */
+			[[noreturn]] void parse_error(parse_status status,
+				const std::string &value,
+				const std::string &option_name,
+				const std::string &type_name)
+			{
+				std::string reason = (status == parse_status::out_of_range ? "is out of range of" : "is not valid");
+				throw invalid_type_exception("Option '" + option_name + "' parsing failed: String '" + value + "' " +
+					reason + " " + type_name + " type.");
+			}
+		}
+
+		parse_status parse_value(std::string_view str, boolean_ini_t &value)
+		{
+			if (str.empty()) {
+				return parse_status::invalid;
+			}
+			const boolean_keyword &keyword = boolean_keywords[boolean_hash(str)];
+			if (keyword.name != str) {
+				return parse_status::invalid;
+			}
+			value = keyword.value;
+			return parse_status::ok;
+		}
+
+		parse_status parse_value(std::string_view str, signed_ini_t &value)
+		{
+			bool negative = parse_sign(str);
+			uint64_t magnitude;
+			parse_status status = parse_magnitude(str, magnitude);
+			if (status != parse_status::ok) {
+				return status;
+			}
+
+			// negative range is by one larger than positive range
+			uint64_t limit = static_cast<uint64_t>(std::numeric_limits<signed_ini_t>::max()) + (negative ? 1 : 0);
+			if (magnitude > limit) {
+				return parse_status::out_of_range;
+			}
+			value = (negative ? static_cast<signed_ini_t>(0 - magnitude) : static_cast<signed_ini_t>(magnitude));
+			return parse_status::ok;
+		}
+
+		parse_status parse_value(std::string_view str, unsigned_ini_t &value)
+		{
+			bool negative = parse_sign(str);
+			uint64_t magnitude;
+			parse_status status = parse_magnitude(str, magnitude);
+			if (status != parse_status::ok) {
+				return status;
+			}
+			if (negative && magnitude != 0) {
+				return parse_status::out_of_range;
+			}
+			value = magnitude;
+			return parse_status::ok;
+		}
+
+		parse_status parse_value(std::string_view str, float_ini_t &value)
+		{
+			bool negative = parse_sign(str);
+			auto format = std::chars_format::general;
+			if (str.length() > 1 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+				format = std::chars_format::hex;
+				str.remove_prefix(2);
+			}
+
+			// sign was already consumed, second one is not allowed
+			if (str.empty() || str.front() == '-' || str.front() == '+') {
+				return parse_status::invalid;
+			}
+
+			float_ini_t result;
+			auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.length(), result, format);
+			if (ptr != str.data() + str.length()) {
+				return parse_status::invalid;
+			}
+			if (ec == std::errc::result_out_of_range) {
+				return parse_status::out_of_range;
+			}
+			if (ec != std::errc()) {
+				return parse_status::invalid;
+			}
+			value = (negative ? -result : result);
+			return parse_status::ok;
+		}
+
+		size_t format_value(signed_ini_t value, char *buffer)
+		{
+			return std::to_chars(buffer, buffer + max_formatted_length, value).ptr - buffer;
+		}
+
+		size_t format_value(unsigned_ini_t value, char *buffer)
+		{
+			return std::to_chars(buffer, buffer + max_formatted_length, value).ptr - buffer;
+		}
+
+		size_t format_value(float_ini_t value, char *buffer)
+		{
+			// without precision the shortest round trip representation is written
+			return std::to_chars(buffer, buffer + max_formatted_length, value).ptr - buffer;
+		}
+
+
 		template <> string_ini_t parse_string<string_ini_t>(const std::string &value, const std::string &)
 		{
 			return value;
 		}
 		template <> boolean_ini_t parse_string<boolean_ini_t>(const std::string &value, const std::string &option_name)
 		{
-			if (value == "0" || value == "f" || value == "n" || value == "off" || value == "no" ||
-				value == "disabled") {
-				return false;
-			} else if (value == "1" || value == "t" || value == "y" || value == "on" || value == "yes" ||
-				value == "enabled") {
-				return true;
-			} else {
-				throw invalid_type_exception(
-					"Option '" + option_name + "' parsing failed: String '" + value + "' is not valid boolean type.");
+			boolean_ini_t result = false;
+			parse_status status = parse_value(value, result);
+			if (status != parse_status::ok) {
+				parse_error(status, value, option_name, "boolean");
 			}
+			return result;
 		}
 
 		template <> enum_ini_t parse_string<enum_ini_t>(const std::string &value, const std::string &)
@@ -108,44 +332,33 @@ namespace inicpp
 
 		template <> float_ini_t parse_string<float_ini_t>(const std::string &value, const std::string &option_name)
 		{
-			try {
-				return std::stod(value);
-			} catch (std::exception &e) {
-				throw invalid_type_exception("Option '" + option_name + "' parsing failed: " + e.what());
+			float_ini_t result = 0;
+			parse_status status = parse_value(value, result);
+			if (status != parse_status::ok) {
+				parse_error(status, value, option_name, "float");
 			}
+			return result;
 		}
 
 		template <> signed_ini_t parse_string<signed_ini_t>(const std::string &value, const std::string &option_name)
 		{
-			try {
-				std::string binary_prefix = "0b";
-				if (std::equal(binary_prefix.begin(), binary_prefix.end(), value.begin())) {
-					// this is binary number
-					return std::stoll(value.substr(2), 0, 2);
-				} else {
-					// decimal and hexadecimal number can handle stoll itself
-					return std::stoll(value, 0, 0);
-				}
-			} catch (std::exception &e) {
-				throw invalid_type_exception("Option '" + option_name + "' parsing failed: " + e.what());
+			signed_ini_t result = 0;
+			parse_status status = parse_value(value, result);
+			if (status != parse_status::ok) {
+				parse_error(status, value, option_name, "signed");
 			}
+			return result;
 		}
 
 		template <>
 		unsigned_ini_t parse_string<unsigned_ini_t>(const std::string &value, const std::string &option_name)
 		{
-			try {
-				std::string binary_prefix = "0b";
-				if (std::equal(binary_prefix.begin(), binary_prefix.end(), value.begin())) {
-					// this is binary number
-					return std::stoull(value.substr(2), 0, 2);
-				} else {
-					// decimal and hexadecimal number can handle stoull itself
-					return std::stoull(value, 0, 0);
-				}
-			} catch (std::exception &e) {
-				throw invalid_type_exception("Option '" + option_name + "' parsing failed: " + e.what());
+			unsigned_ini_t result = 0;
+			parse_status status = parse_value(value, result);
+			if (status != parse_status::ok) {
+				parse_error(status, value, option_name, "unsigned");
 			}
+			return result;
 		}
 	}
 
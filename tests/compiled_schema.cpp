@@ -0,0 +1,164 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "compiled_schema.h"
+#include "parser.h"
+#include "schema.h"
+
+using namespace inicpp;
+
+
+namespace
+{
+	schema validation_schema()
+	{
+		schema schm;
+		section_schema_params server_params;
+		server_params.name = "server";
+		schm.add_section(server_params);
+		section_schema_params limits_params;
+		limits_params.name = "limits";
+		limits_params.requirement = item_requirement::optional;
+		schm.add_section(limits_params);
+
+		option_schema_params<unsigned_ini_t> port_params;
+		port_params.name = "port";
+		port_params.validator = [](unsigned_ini_t port) { return port > 0 && port < 65536; };
+		schm.add_option("server", port_params);
+		option_schema_params<string_ini_t> hosts_params;
+		hosts_params.name = "hosts";
+		hosts_params.type = option_item::list;
+		hosts_params.validator = [](string_ini_t host) { return !host.empty(); };
+		schm.add_option("server", hosts_params);
+		option_schema_params<boolean_ini_t> verbose_params;
+		verbose_params.name = "verbose";
+		verbose_params.requirement = item_requirement::optional;
+		verbose_params.default_value = "off";
+		schm.add_option("server", verbose_params);
+		option_schema_params<float_ini_t> ratio_params;
+		ratio_params.name = "ratio";
+		ratio_params.requirement = item_requirement::optional;
+		ratio_params.default_value = "0.5";
+		ratio_params.validator = [](float_ini_t ratio) { return ratio >= 0 && ratio <= 1; };
+		schm.add_option("limits", ratio_params);
+		option_schema_params<signed_ini_t> offsets_params;
+		offsets_params.name = "offsets";
+		offsets_params.type = option_item::list;
+		offsets_params.requirement = item_requirement::optional;
+		offsets_params.default_value = "-1, 1";
+		schm.add_option("limits", offsets_params);
+		return schm;
+	}
+
+	/**
+	 * Validate config with schema and compiled schema, results have to be the same.
+	 */
+	void expect_same_validation(const schema &schm, const compiled_schema &plan, const std::string &text)
+	{
+		for (auto mode : {schema_mode::relaxed, schema_mode::strict}) {
+			config expected = parser::load(text);
+			config validated = parser::load(text);
+			std::string expected_error;
+			std::string error;
+			try {
+				schm.validate_config(expected, mode);
+			} catch (validation_exception &e) {
+				expected_error = e.what();
+			}
+			try {
+				plan.validate(validated, mode);
+			} catch (validation_exception &e) {
+				error = e.what();
+			}
+			EXPECT_EQ(error, expected_error) << text;
+			if (expected_error.empty()) {
+				EXPECT_EQ(validated, expected) << text;
+			}
+		}
+	}
+}
+
+TEST(compiled_schema, same_results_as_schema)
+{
+	schema schm = validation_schema();
+	compiled_schema plan = schm.compile();
+
+	expect_same_validation(schm, plan, "[server]\nport = 80\nhosts = a, b\n");
+	expect_same_validation(schm, plan, "[server]\nport = 80\nhosts = a, b\nverbose = yes\n[limits]\nratio = 1\n");
+	expect_same_validation(schm, plan, "[limits]\nratio = 0.2\n[server]\nhosts = a, b\nport = 0x50\nextra = 1\n");
+	expect_same_validation(schm, plan, "[server]\nport = 80\nhosts = a, b\n[unknown]\n");
+	expect_same_validation(schm, plan, "[server]\nport = 80\n");
+	expect_same_validation(schm, plan, "[limits]\n");
+	expect_same_validation(schm, plan, "[server]\nport = 70000\nhosts = a, b\n");
+	expect_same_validation(schm, plan, "[server]\nport = 80\nhosts = a\n");
+	expect_same_validation(schm, plan, "[server]\nport = 80, 81\nhosts = a, b\n");
+	expect_same_validation(schm, plan, "[server]\nport = 80\nhosts = a, b\n[limits]\nratio = 2\n");
+	expect_same_validation(schm, plan, "[server]\nport = 80\nhosts = a, b\n[limits]\noffsets = 1\n");
+
+	config cfg = parser::load("[server]\nport = 80\nhosts = a, b\n");
+	cfg.validate(plan, schema_mode::strict);
+	EXPECT_EQ(cfg["server"]["port"].get_type(), option_type::unsigned_e);
+	EXPECT_FALSE(cfg["server"]["verbose"].get<boolean_ini_t>());
+	EXPECT_EQ(cfg["limits"]["offsets"].get<string_ini_t>(), "-1, 1");
+	EXPECT_THROW(parser::load("[server]\nport = x\nhosts = a, b\n").validate(plan, schema_mode::relaxed),
+		invalid_type_exception);
+}
+
+TEST(compiled_schema, independent_of_source)
+{
+	schema schm = validation_schema();
+	compiled_schema plan = schm.compile();
+	compiled_schema copy = plan;
+	option_schema_params<string_ini_t> name_params;
+	name_params.name = "name";
+	schm.add_option("server", name_params);
+	EXPECT_FALSE(copy.get_schema()["server"].contains("name"));
+	std::string text_without_name = "[server]\nport = 80\nhosts = a, b\n";
+	EXPECT_NO_THROW(parser::load(text_without_name).validate(copy, schema_mode::strict));
+	EXPECT_THROW(parser::load(text_without_name).validate(schm, schema_mode::strict), validation_exception);
+
+	// many names are still found by one lookup
+	schema large;
+	section_schema_params sect_params;
+	sect_params.requirement = item_requirement::optional;
+	option_schema_params<unsigned_ini_t> opt_params;
+	opt_params.requirement = item_requirement::optional;
+	opt_params.default_value = "0";
+	std::string text;
+	for (size_t i = 0; i < 300; ++i) {
+		sect_params.name = "section" + std::to_string(i);
+		large.add_section(sect_params);
+		opt_params.name = "option" + std::to_string(i);
+		large.add_option(sect_params.name, opt_params);
+		text += "[" + sect_params.name + "]\n" + opt_params.name + " = " + std::to_string(i) + "\n";
+	}
+	compiled_schema large_plan = large.compile();
+	config large_cfg = parser::load(text);
+	large_cfg.validate(large_plan, schema_mode::strict);
+	EXPECT_EQ(large_cfg["section299"]["option299"].get<unsigned_ini_t>(), 299u);
+	EXPECT_EQ(large_cfg["section0"].size(), 1u);
+}
+
+TEST(compiled_schema, concurrent_validation)
+{
+	const compiled_schema plan = validation_schema().compile();
+	std::string text = "[server]\nport = 80\nhosts = a, b\n[limits]\nratio = 0.25\noffsets = 2, 3\n";
+	config expected = parser::load(text);
+	plan.validate(expected, schema_mode::strict);
+
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < 4; ++i) {
+		threads.emplace_back([&]() {
+			for (size_t j = 0; j < 200; ++j) {
+				config cfg = parser::load(text);
+				plan.validate(cfg, schema_mode::strict);
+				ASSERT_EQ(cfg, expected);
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+}
@@ -1,6 +1,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
 #include "config.h"
 #include "option.h"
 #include "section.h"
@@ -8,6 +13,49 @@
 using namespace inicpp;
 
 
+namespace
+{
+	/** True while allocations are counted */
+	std::atomic<bool> counting_allocations(false);
+	/** Number of counted allocations */
+	std::atomic<size_t> allocation_count(0);
+
+	/**
+	 * Count allocations made by given function. Copy of an option allocates
+	 * its values again, so the count shows whether insertion copied them.
+	 */
+	template <typename Function> size_t count_allocations(Function function)
+	{
+		allocation_count = 0;
+		counting_allocations = true;
+		function();
+		counting_allocations = false;
+		return allocation_count;
+	}
+}
+
+void *operator new(std::size_t size)
+{
+	if (counting_allocations) {
+		allocation_count++;
+	}
+	if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+
 TEST(config, creation_and_assignments)
 {
 	config conf;
@@ -59,6 +107,231 @@ TEST(config, adding_and_removing_options)
 	EXPECT_EQ(conf["sect"][0].get_name(), "opt2");
 }
 
+TEST(config, name_lookups)
+{
+	config conf;
+	conf.add_section("sect");
+	conf.add_option<string_ini_t>("sect", "opt", "value");
+	const config &const_conf = conf;
+
+	// any string-like name can be used without creating a string
+	std::string_view sect_name = std::string_view("sect_and_more").substr(0, 4);
+	EXPECT_TRUE(conf.contains(sect_name));
+	EXPECT_TRUE(conf.contains(std::string("sect")));
+	EXPECT_FALSE(conf.contains("sec"));
+	EXPECT_EQ(&const_conf[sect_name], &conf["sect"]);
+	EXPECT_TRUE(const_conf[sect_name].contains(std::string_view("opt")));
+	EXPECT_EQ(const_conf[sect_name][std::string_view("opt")].get<string_ini_t>(), "value");
+	EXPECT_THROW(const_conf[std::string_view("missing")], not_found_exception);
+	EXPECT_THROW(conf["sect"][std::string_view("missing")], not_found_exception);
+}
+
+TEST(config, non_throwing_lookups)
+{
+	config conf;
+	conf.add_section("sect");
+	conf.add_option<string_ini_t>("sect", "number", "12");
+	const config &const_conf = conf;
+
+	EXPECT_EQ(conf.find("sect"), &conf["sect"]);
+	EXPECT_EQ(const_conf.find("missing"), nullptr);
+	EXPECT_EQ(conf["sect"].find("number"), &conf["sect"]["number"]);
+	EXPECT_EQ(const_conf["sect"].find("missing"), nullptr);
+
+	EXPECT_EQ(conf.try_get<signed_ini_t>("sect", "number"), std::optional<signed_ini_t>(12));
+	EXPECT_FALSE(conf.try_get<signed_ini_t>("sect", "missing").has_value());
+	EXPECT_FALSE(conf.try_get<signed_ini_t>("missing", "number").has_value());
+	EXPECT_FALSE(conf["sect"].try_get<boolean_ini_t>("number").has_value());
+	EXPECT_EQ(conf.get_or<unsigned_ini_t>("sect", "number", 5), 12u);
+	EXPECT_EQ(conf.get_or<unsigned_ini_t>("sect", "missing", 5), 5u);
+	EXPECT_EQ(conf.get_or<string_ini_t>("missing", "number", "none"), "none");
+	EXPECT_EQ(conf["sect"].get_or<float_ini_t>("number", 1.5), 12.0);
+}
+
+TEST(config, shared_copies)
+{
+	config conf;
+	conf.add_section("first");
+	conf.add_section("second");
+	conf.add_option<signed_ini_t>("first", "number", 1);
+	conf.add_option<signed_ini_t>("second", "number", 2);
+
+	// copy shares sections and options until they are modified
+	config copy = conf;
+	const config &const_conf = conf;
+	const config &const_copy = copy;
+	EXPECT_EQ(&const_copy["first"], &const_conf["first"]);
+	EXPECT_EQ(&const_copy["second"]["number"], &const_conf["second"]["number"]);
+
+	copy["first"]["number"].set<signed_ini_t>(10);
+	EXPECT_EQ(const_conf["first"]["number"].get<signed_ini_t>(), 1);
+	EXPECT_EQ(const_copy["first"]["number"].get<signed_ini_t>(), 10);
+	EXPECT_NE(&const_copy["first"], &const_conf["first"]);
+	EXPECT_EQ(&const_copy["second"], &const_conf["second"]);
+
+	// non-constant iteration clones shared nodes as well
+	config iterated = conf;
+	for (auto &sect : iterated) {
+		for (auto &opt : sect) {
+			opt.set<signed_ini_t>(opt.get<signed_ini_t>() + 100);
+		}
+	}
+	EXPECT_EQ(const_conf["second"]["number"].get<signed_ini_t>(), 2);
+	EXPECT_EQ(iterated["second"]["number"].get<signed_ini_t>(), 102);
+	EXPECT_EQ(iterated.find("first")->find("number")->get<signed_ini_t>(), 101);
+
+	// modifying methods of copy and of the source clone too
+	copy.add_option<boolean_ini_t>("second", "added", true);
+	EXPECT_FALSE(conf["second"].contains("added"));
+	EXPECT_TRUE(copy["second"].contains("added"));
+	conf.remove_option("second", "number");
+	EXPECT_EQ(copy["second"]["number"].get<signed_ini_t>(), 2);
+	section sect = copy["second"];
+	sect.mutable_option("added").set<boolean_ini_t>(false);
+	EXPECT_TRUE(copy["second"]["added"].get<boolean_ini_t>());
+}
+
+TEST(config, reads_do_not_clone)
+{
+	config conf;
+	conf.add_section("sect");
+	conf.add_option<signed_ini_t>("sect", "number", 1);
+	config copy = conf;
+	const config &const_conf = conf;
+	const config &const_copy = copy;
+	const section *shared = &const_conf["sect"];
+	const option *shared_option = &const_conf["sect"]["number"];
+
+	// constant lookups and iteration only read shared nodes
+	EXPECT_EQ(&const_copy["sect"], shared);
+	EXPECT_EQ(const_copy.find("sect"), shared);
+	EXPECT_EQ(&const_copy[0], shared);
+	EXPECT_EQ(&*const_copy.begin(), shared);
+	for (auto &sect : const_copy) {
+		for (auto &opt : sect) {
+			EXPECT_EQ(&opt, shared_option);
+		}
+	}
+	EXPECT_EQ(const_copy["sect"].find("number"), shared_option);
+	EXPECT_EQ(copy.get_or<signed_ini_t>("sect", "number", 0), 1);
+	EXPECT_EQ(copy.try_get<signed_ini_t>("sect", "number"), std::optional<signed_ini_t>(1));
+	EXPECT_EQ(&const_conf["sect"], shared);
+	EXPECT_EQ(&const_copy["sect"]["number"], shared_option);
+
+	// validation clones only options which are parsed to other type
+	schema schm;
+	section_schema_params sect_params;
+	sect_params.name = "sect";
+	schm.add_section(sect_params);
+	option_schema_params<signed_ini_t> opt_params;
+	opt_params.name = "number";
+	schm.add_option("sect", opt_params);
+	copy.validate(schm.compile(), schema_mode::strict);
+	EXPECT_EQ(&const_copy["sect"], shared);
+	EXPECT_EQ(&const_copy["sect"]["number"], shared_option);
+
+	// non-constant access is modification, it gets its own clone
+	EXPECT_NE(&copy["sect"]["number"], shared_option);
+	EXPECT_EQ(&const_conf["sect"]["number"], shared_option);
+}
+
+TEST(config, references_before_copy)
+{
+	config conf;
+	conf.add_section("sect");
+	conf.add_option<signed_ini_t>("sect", "number", 1);
+	conf.add_option<signed_ini_t>("sect", "other", 2);
+	section &sect = conf.mutable_section("sect");
+	option &number = sect.mutable_option("number");
+
+	// writes through the copy are not visible through references of the source
+	config copy = conf;
+	copy.mutable_section("sect").mutable_option("number").set<signed_ini_t>(10);
+	copy.remove_option("sect", "other");
+	EXPECT_EQ(number.get<signed_ini_t>(), 1);
+	EXPECT_TRUE(sect.contains("other"));
+
+	// and writes through the references are not visible in the copy
+	config second_copy = conf;
+	number.set<signed_ini_t>(20);
+	sect.add_option<signed_ini_t>("added", 3);
+	EXPECT_EQ(conf["sect"]["number"].get<signed_ini_t>(), 20);
+	EXPECT_EQ(second_copy["sect"]["number"].get<signed_ini_t>(), 1);
+	EXPECT_FALSE(second_copy["sect"].contains("added"));
+	EXPECT_EQ(copy["sect"]["number"].get<signed_ini_t>(), 10);
+
+	// untouched options are still shared by the copy of exposed section
+	EXPECT_EQ(&std::as_const(second_copy)["sect"]["other"], &std::as_const(conf)["sect"]["other"]);
+
+	// the same holds for references from non-constant lookups
+	option &looked_up = conf["sect"]["other"];
+	config fourth_copy = conf;
+	looked_up.set<signed_ini_t>(30);
+	EXPECT_EQ(fourth_copy["sect"]["other"].get<signed_ini_t>(), 2);
+
+	// emplaced section is given out as well
+	section &emplaced = conf.emplace_section("emplaced");
+	config third_copy = conf;
+	emplaced.add_option<signed_ini_t>("added", 4);
+	EXPECT_FALSE(third_copy["emplaced"].contains("added"));
+}
+
+TEST(config, moves_and_emplace)
+{
+	static_assert(std::is_nothrow_move_constructible<config>::value, "config move may throw");
+	static_assert(std::is_nothrow_move_assignable<config>::value, "config move may throw");
+	static_assert(std::is_nothrow_move_constructible<section>::value, "section move may throw");
+	static_assert(std::is_nothrow_move_assignable<section>::value, "section move may throw");
+	static_assert(std::is_nothrow_move_constructible<option>::value, "option move may throw");
+	static_assert(std::is_nothrow_move_assignable<option>::value, "option move may throw");
+
+	// emplaced objects are never copied, so they keep their addresses
+	config conf;
+	section &sect = conf.emplace_section("sect");
+	option &opt = sect.emplace_option("opt", std::vector<std::string>{"1", "2"});
+	EXPECT_EQ(&conf["sect"], &sect);
+	EXPECT_EQ(&conf["sect"]["opt"], &opt);
+	EXPECT_THROW(conf.emplace_section("sect"), ambiguity_exception);
+	EXPECT_THROW(sect.emplace_option("opt"), ambiguity_exception);
+
+	// moved section keeps its options
+	section other("other", index_policy::hashed);
+	option &moved_opt = other.emplace_option("value", "text");
+	conf.add_section(std::move(other));
+	EXPECT_EQ(&conf["other"]["value"], &moved_opt);
+
+	option added("added", "value");
+	conf.add_option("other", std::move(added));
+	EXPECT_EQ(conf["other"]["added"].get<string_ini_t>(), "value");
+	EXPECT_THROW(conf.add_option("missing", option("added")), not_found_exception);
+
+	config moved(std::move(conf));
+	EXPECT_EQ(&moved["sect"], &sect);
+}
+
+TEST(config, moves_and_emplace_do_not_copy)
+{
+	// copy allocates every value again, move and emplace only allocate the new node
+	std::vector<std::string> values(100, std::string(64, 'x'));
+	section sect("sect");
+	option copied("copied", values);
+	EXPECT_GE(count_allocations([&]() { sect.add_option(copied); }), values.size());
+
+	option moved("moved", values);
+	EXPECT_LT(count_allocations([&]() { sect.add_option(std::move(moved)); }), 10u);
+	std::vector<std::string> emplaced_values = values;
+	EXPECT_LT(count_allocations([&]() { sect.emplace_option("emplaced", std::move(emplaced_values)); }), 10u);
+	EXPECT_EQ(sect["emplaced"].get_list<string_ini_t>(), values);
+
+	config conf;
+	conf.add_section("other");
+	option added("added", values);
+	EXPECT_LT(count_allocations([&]() { conf.add_option("other", std::move(added)); }), 10u);
+	EXPECT_LT(count_allocations([&]() { conf.add_section(std::move(sect)); }), 10u);
+	EXPECT_EQ(conf["sect"]["moved"].get_list<string_ini_t>(), values);
+	EXPECT_EQ(conf["other"]["added"].get_list<string_ini_t>(), values);
+}
+
 TEST(config, iterators)
 {
 	config conf;
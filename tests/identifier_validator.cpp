@@ -0,0 +1,42 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "identifier_validator.h"
+
+using namespace inicpp;
+
+
+TEST(identifier_validator, default_rules)
+{
+	identifier_validator validator;
+
+	EXPECT_TRUE(validator.is_valid("section"));
+	EXPECT_TRUE(validator.is_valid("Section 1"));
+	EXPECT_TRUE(validator.is_valid("$Section::subsection"));
+	EXPECT_TRUE(validator.is_valid(".a-b_c~d"));
+	EXPECT_TRUE(validator.is_valid("a"));
+
+	EXPECT_FALSE(validator.is_valid(""));
+	EXPECT_FALSE(validator.is_valid("1section"));
+	EXPECT_FALSE(validator.is_valid("-section"));
+	EXPECT_FALSE(validator.is_valid(" section"));
+	EXPECT_FALSE(validator.is_valid("sect#ion"));
+	EXPECT_FALSE(validator.is_valid("sect=ion"));
+	EXPECT_FALSE(validator.is_valid("sect\xe1ion"));
+}
+
+TEST(identifier_validator, custom_rules)
+{
+	identifier_validator strict("a-z", "a-z0-9_");
+	EXPECT_TRUE(strict.is_valid("abc_1"));
+	EXPECT_FALSE(strict.is_valid("Abc"));
+	EXPECT_FALSE(strict.is_valid("abc-1"));
+	EXPECT_FALSE(strict.is_valid("abc 1"));
+
+	// dash at the end of set is taken literally
+	identifier_validator dashes("a-c-", "x-");
+	EXPECT_TRUE(dashes.is_valid("-x-"));
+	EXPECT_TRUE(dashes.is_valid("bx"));
+	EXPECT_FALSE(dashes.is_valid("dx"));
+	EXPECT_FALSE(dashes.is_valid("ay"));
+}
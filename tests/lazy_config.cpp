@@ -0,0 +1,131 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "parser.h"
+
+using namespace inicpp;
+
+
+TEST(lazy_config, parse_on_access)
+{
+	std::string str_config = ";comment\n"
+							 "[first]\n"
+							 "a = 1, 2\n"
+							 "[second] ; with comment\n"
+							 "b = ${first#a}\n"
+							 "  [third]\n"
+							 "c = wrong\\\n"
+							 "d\n";
+
+	lazy_config cfg = parser::load_lazy(str_config);
+	EXPECT_EQ(cfg.size(), 3u);
+	EXPECT_TRUE(cfg.contains("third"));
+	EXPECT_FALSE(cfg.contains("fourth"));
+	EXPECT_FALSE(cfg.is_parsed("first"));
+	EXPECT_THROW(cfg.is_parsed("fourth"), not_found_exception);
+
+	// linked section is parsed together with the accessed one
+	EXPECT_EQ(cfg["second"]["b"].get<string_ini_t>(), "1");
+	EXPECT_TRUE(cfg.is_parsed("first"));
+	EXPECT_TRUE(cfg.is_parsed("second"));
+	EXPECT_FALSE(cfg.is_parsed("third"));
+	EXPECT_EQ(cfg[0]["a"].get_list<signed_ini_t>(), std::vector<signed_ini_t>({1, 2}));
+
+	// error in section body is reported on access with correct line number
+	try {
+		cfg["third"];
+		FAIL() << "parser_exception expected";
+	} catch (parser_exception &e) {
+		EXPECT_STREQ(e.what(), "Unknown element option expected on line 8");
+	}
+	EXPECT_THROW(cfg[3], not_found_exception);
+
+	// iteration parses sections in order
+	lazy_config iterated = parser::load_lazy("[a]\nx = 1\n[b]\ny = 2\n");
+	std::vector<std::string> names;
+	for (auto &sect : iterated) {
+		names.push_back(sect.get_name());
+	}
+	EXPECT_EQ(names, std::vector<std::string>({"a", "b"}));
+}
+
+TEST(lazy_config, load_errors)
+{
+	// headers and text before the first section are checked by loading
+	EXPECT_THROW(parser::load_lazy("[a]\n[b\n"), parser_exception);
+	EXPECT_THROW(parser::load_lazy("opt = 1\n[a]\n"), parser_exception);
+	EXPECT_THROW(parser::load_lazy("[a]\nx = 1\n[a]\n"), ambiguity_exception);
+
+	// links are resolved on access, broken link does not affect other sections
+	lazy_config cfg = parser::load_lazy("[a]\nx = ${b#y}\n[b]\ny = 1\nz = ${b#w}\n[c]\nw = ${c#w}\n");
+	EXPECT_EQ(cfg["a"]["x"].get<signed_ini_t>(), 1);
+	EXPECT_THROW(cfg["b"], parser_exception);
+	EXPECT_THROW(cfg["b"], parser_exception);
+	EXPECT_THROW(cfg["c"], parser_exception);
+}
+
+TEST(lazy_config, malformed_linked_section)
+{
+	lazy_config cfg = parser::load_lazy("[good]\nx = ${bad#y}\n[bad]\ny = ${other#z}\nbroken line\n"
+										"[other]\nz = 1\n[linked]\nw = ${other#z}\n");
+
+	// failed parsing leaves no nodes of destroyed options behind, so every access reports the error
+	EXPECT_THROW(cfg["bad"], parser_exception);
+	EXPECT_THROW(cfg["bad"], parser_exception);
+	EXPECT_FALSE(cfg.is_parsed("bad"));
+	EXPECT_THROW(cfg["good"], parser_exception);
+	EXPECT_THROW(cfg["good"], parser_exception);
+	EXPECT_EQ(cfg["linked"]["w"].get<signed_ini_t>(), 1);
+	EXPECT_EQ(cfg["other"]["z"].get<signed_ini_t>(), 1);
+}
+
+TEST(lazy_config, schema_validation)
+{
+	schema schm;
+	section_schema_params mandatory_params;
+	mandatory_params.name = "mandatory";
+	schm.add_section(mandatory_params);
+	section_schema_params optional_params;
+	optional_params.name = "optional";
+	optional_params.requirement = item_requirement::optional;
+	schm.add_section(optional_params);
+
+	option_schema_params<signed_ini_t> number_params;
+	number_params.name = "number";
+	number_params.requirement = item_requirement::optional;
+	number_params.default_value = "42";
+	schm.add_option("mandatory", number_params);
+	schm.add_option("optional", number_params);
+
+	lazy_config cfg = parser::load_lazy("[mandatory]\nnumber = 5\n[other]\n", schm, schema_mode::relaxed);
+	EXPECT_EQ(cfg.size(), 3u);
+	EXPECT_EQ(cfg["mandatory"]["number"].get<signed_ini_t>(), 5);
+	EXPECT_EQ(cfg["optional"]["number"].get<string_ini_t>(), "42");
+
+	// section is validated on access
+	lazy_config invalid = parser::load_lazy("[mandatory]\nnumber = text\n", schm, schema_mode::relaxed);
+	EXPECT_THROW(invalid["mandatory"], invalid_type_exception);
+
+	// names of sections are validated by loading
+	EXPECT_THROW(parser::load_lazy("[optional]\n", schm, schema_mode::relaxed), validation_exception);
+	EXPECT_THROW(parser::load_lazy("[mandatory]\n[other]\n", schm, schema_mode::strict), validation_exception);
+}
+
+TEST(lazy_config, load_file)
+{
+	std::string file_name = "inicpp_lazy_config_test.ini";
+	{
+		std::ofstream output(file_name);
+		output << "[section]\nopt = value\n";
+	}
+
+	lazy_config cfg = parser::load_file_lazy(file_name);
+	lazy_config moved = std::move(cfg);
+	EXPECT_EQ(moved["section"]["opt"].get<string_ini_t>(), "value");
+
+	std::remove(file_name.c_str());
+	EXPECT_THROW(parser::load_file_lazy(file_name), parser_exception);
+}
@@ -0,0 +1,56 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "name_index.h"
+#include "option.h"
+
+using namespace inicpp;
+
+
+namespace
+{
+	/**
+	 * Check that every option of the vector is found on its position.
+	 */
+	void expect_indexed(const name_index<option> &index, const std::vector<std::shared_ptr<option>> &items)
+	{
+		for (size_t i = 0; i < items.size(); ++i) {
+			EXPECT_EQ(index.find(items[i]->get_name(), items), i);
+		}
+	}
+}
+
+
+TEST(name_index, policies)
+{
+	for (auto policy : {index_policy::ordered, index_policy::hashed}) {
+		name_index<option> index(policy);
+		std::vector<std::shared_ptr<option>> items;
+		EXPECT_EQ(index.get_policy(), policy);
+		EXPECT_EQ(index.find("missing", items), index.npos);
+
+		// enough items to grow the hash table several times
+		for (size_t i = 0; i < 1000; ++i) {
+			items.push_back(std::make_shared<option>("opt" + std::to_string(i)));
+			index.push_back(items);
+		}
+		expect_indexed(index, items);
+		EXPECT_EQ(index.find("opt1000", items), index.npos);
+		EXPECT_EQ(index.find("", items), index.npos);
+
+		// removed items are not found and the following ones shift
+		for (size_t position : {999, 500, 0}) {
+			std::string name = items[position]->get_name();
+			items.erase(items.begin() + position);
+			index.erase(name, position, items);
+			EXPECT_EQ(index.find(name, items), index.npos);
+		}
+		expect_indexed(index, items);
+
+		// copy indexes the same positions
+		name_index<option> copy(index);
+		expect_indexed(copy, items);
+	}
+}
@@ -138,6 +138,107 @@ TEST(option, copying)
 	EXPECT_EQ(moved_assignment.get<string_ini_t>(), my_option.get<string_ini_t>());
 }
 
+/**
+ * Values are stored in their type, reading in other type converts them.
+ */
+TEST(option, typed_storage)
+{
+	option my_option("name");
+	my_option.set_list<signed_ini_t>({-1, 2});
+	EXPECT_EQ(my_option.get_type(), option_type::signed_e);
+	EXPECT_EQ(my_option.get_list<float_ini_t>(), std::vector<float_ini_t>({-1.0, 2.0}));
+	EXPECT_EQ(my_option.get_list<string_ini_t>(), std::vector<string_ini_t>({"-1", "2"}));
+	EXPECT_THROW(my_option.get<enum_ini_t>(), bad_cast_exception);
+
+	// strings are parsed when read in other type
+	option text("text", std::vector<std::string>{"0x10", "7"});
+	EXPECT_EQ(text.get_list<unsigned_ini_t>(), std::vector<unsigned_ini_t>({16, 7}));
+	EXPECT_THROW(text.get<boolean_ini_t>(), bad_cast_exception);
+
+	// lists of booleans and enums
+	option flags("flags");
+	flags.set_list<boolean_ini_t>({true, false});
+	flags.add_to_list<boolean_ini_t>(true, 1);
+	EXPECT_EQ(flags.get_list<boolean_ini_t>(), std::vector<boolean_ini_t>({true, true, false}));
+	flags.remove_from_list<boolean_ini_t>(false);
+	EXPECT_EQ(flags.get_list<boolean_ini_t>(), std::vector<boolean_ini_t>({true, true}));
+
+	option modes("modes");
+	modes.set_list<enum_ini_t>({"fast", "slow"});
+	option other_modes = modes;
+	EXPECT_EQ(modes, other_modes);
+	other_modes.remove_from_list<enum_ini_t>("slow");
+	EXPECT_NE(modes, other_modes);
+	EXPECT_EQ(other_modes.get<string_ini_t>(), "fast");
+
+	// empty list keeps its type
+	option empty("empty");
+	empty.set_list<float_ini_t>({});
+	EXPECT_EQ(empty.get_type(), option_type::float_e);
+	EXPECT_THROW(empty.get<float_ini_t>(), not_found_exception);
+	EXPECT_THROW(empty.remove_from_list_pos(0), not_found_exception);
+}
+
+TEST(option, conversion_cache)
+{
+	option tunable("tunable", std::vector<std::string>{"42", "7"});
+	EXPECT_EQ(tunable.get<signed_ini_t>(), 42);
+	EXPECT_EQ(tunable.get<signed_ini_t>(), 42);
+	EXPECT_DOUBLE_EQ(tunable.get<float_ini_t>(), 42.0);
+	EXPECT_THROW(tunable.get<boolean_ini_t>(), bad_cast_exception);
+
+	// every modification drops cached values
+	tunable.remove_from_list_pos(0);
+	EXPECT_EQ(tunable.get<unsigned_ini_t>(), 7u);
+	tunable.add_to_list<string_ini_t>("-3", 0);
+	EXPECT_EQ(tunable.get<signed_ini_t>(), -3);
+	EXPECT_THROW(tunable.get<unsigned_ini_t>(), bad_cast_exception);
+	tunable.remove_from_list<string_ini_t>("-3");
+	EXPECT_EQ(tunable.get<signed_ini_t>(), 7);
+	tunable.set_list<string_ini_t>({"on"});
+	EXPECT_TRUE(tunable.get<boolean_ini_t>());
+	tunable = "off";
+	EXPECT_FALSE(tunable.get<boolean_ini_t>());
+	tunable.set<signed_ini_t>(5);
+	EXPECT_DOUBLE_EQ(tunable.get<float_ini_t>(), 5.0);
+
+	// copies do not share cache with the source
+	option source("source", "1");
+	EXPECT_EQ(source.get<signed_ini_t>(), 1);
+	option copy = source;
+	copy = "2";
+	EXPECT_EQ(copy.get<signed_ini_t>(), 2);
+	EXPECT_EQ(source.get<signed_ini_t>(), 1);
+}
+
+TEST(option, non_throwing_getters)
+{
+	option text("text", std::vector<std::string>{"0x10", "bad"});
+	EXPECT_EQ(text.try_get<unsigned_ini_t>(), std::optional<unsigned_ini_t>(16));
+	EXPECT_EQ(text.try_get<signed_ini_t>(), std::optional<signed_ini_t>(16));
+	EXPECT_EQ(text.try_get<enum_ini_t>(), std::optional<enum_ini_t>("0x10"));
+	EXPECT_FALSE(text.try_get<boolean_ini_t>().has_value());
+	EXPECT_TRUE(text.get_or<boolean_ini_t>(true));
+	EXPECT_EQ(text.get_or<string_ini_t>("default"), "0x10");
+	text.remove_from_list_pos(0);
+	EXPECT_FALSE(text.try_get<unsigned_ini_t>().has_value());
+	EXPECT_EQ(text.get_or<unsigned_ini_t>(3), 3u);
+
+	// conversions which throw in get() give empty result
+	option number("number");
+	number.set<signed_ini_t>(-2);
+	EXPECT_EQ(number.try_get<float_ini_t>(), std::optional<float_ini_t>(-2.0));
+	EXPECT_EQ(number.try_get<string_ini_t>(), std::optional<string_ini_t>("-2"));
+	EXPECT_FALSE(number.try_get<enum_ini_t>().has_value());
+	option mode("mode");
+	mode.set<enum_ini_t>("fast");
+	EXPECT_FALSE(mode.try_get<float_ini_t>().has_value());
+	EXPECT_EQ(mode.get_or<string_ini_t>(""), "fast");
+	option empty("empty");
+	empty.set_list<signed_ini_t>({});
+	EXPECT_FALSE(empty.try_get<signed_ini_t>().has_value());
+}
+
 /**
  * Test format of output stream.
  */
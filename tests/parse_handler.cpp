@@ -0,0 +1,106 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "parser.h"
+
+using namespace inicpp;
+
+
+/**
+ * Handler which records all received events as text.
+ */
+class recording_handler : public parse_handler
+{
+public:
+	std::vector<std::string> events;
+	bool recover = false;
+
+	void on_section(std::string_view name) override
+	{
+		events.push_back("section " + std::string(name));
+	}
+
+	void on_option(std::string_view name, std::vector<std::string> &values) override
+	{
+		std::string event = "option " + std::string(name) + " @" + std::to_string(get_line_number());
+		for (auto &value : values) {
+			event += " <" + value + ">";
+		}
+		events.push_back(event);
+	}
+
+	void on_comment(std::string_view comment) override
+	{
+		events.push_back("comment " + std::string(comment));
+	}
+
+	void on_error(const std::string &message, size_t line_number) override
+	{
+		if (!recover) {
+			parse_handler::on_error(message, line_number);
+		}
+		events.push_back("error " + message);
+	}
+};
+
+
+TEST(parse_handler, events)
+{
+	std::string str = ";header\n"
+					  "[first]\n"
+					  "a = 1, 2 ; trailing\n"
+					  "b = ${first#a}\n"
+					  "[second]\n"
+					  "c = x\\,y\n";
+	std::vector<std::string> expected = {"comment header",
+		"section first",
+		"option a @3 <1> <2>",
+		"comment trailing",
+		"option b @4 <${first#a}>",
+		"section second",
+		"option c @6 <x,y>"};
+
+	recording_handler handler;
+	parser::parse(str, handler);
+	EXPECT_EQ(handler.events, expected);
+
+	// stream input generates the same events
+	recording_handler stream_handler;
+	std::istringstream stream{str};
+	parser::parse(stream, stream_handler);
+	EXPECT_EQ(stream_handler.events, expected);
+}
+
+TEST(parse_handler, errors)
+{
+	std::string str = "a = 1\n"
+					  "[sect]\n"
+					  "[bad\n"
+					  "b = ${#x}\n"
+					  "c = 2\n";
+
+	// default handler throws on first malformed line
+	parse_handler silent;
+	EXPECT_THROW(parser::parse(str, silent), parser_exception);
+	recording_handler throwing;
+	EXPECT_THROW(parser::parse(str, throwing), parser_exception);
+	EXPECT_TRUE(throwing.events.empty());
+
+	// handler can skip malformed lines and continue
+	recording_handler handler;
+	handler.recover = true;
+	parser::parse(str, handler);
+	std::vector<std::string> expected = {"error Option not in section on line 1",
+		"section sect",
+		"error Section not ended on line 3",
+		"error Section name in link cannot be empty on line 4",
+		"option c @5 <2>"};
+	EXPECT_EQ(handler.events, expected);
+
+	// unresolvable links are not errors of the streaming parser
+	parse_handler links;
+	EXPECT_NO_THROW(parser::parse("[s]\na = ${missing#option}", links));
+	EXPECT_THROW(parser::load("[s]\na = ${missing#option}"), parser_exception);
+}
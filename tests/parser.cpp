@@ -1,8 +1,18 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
 #include "parser.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
 using namespace inicpp;
 
 /*
@@ -131,3 +141,320 @@ TEST(parser, store_config)
 								  "unsigned = 42\n";
 	EXPECT_EQ(str.str(), expected_result);
 }
+
+TEST(parser, load_from_buffer)
+{
+	// only part of the buffer is parsed, the rest must not be touched
+	std::string buffer = ""
+						 "[section]\n"
+						 "opt = \\ val\\ \n"
+						 "escaped = a\\,b, c \\; not comment ; comment\n"
+						 "list = v1:v2:v3\n"
+						 "[skipped]";
+	std::string_view view(buffer.data(), buffer.find("[skipped]"));
+
+	auto loaded_config = parser::load(view);
+	EXPECT_EQ(loaded_config.size(), 1u);
+	EXPECT_EQ(loaded_config[0].size(), 3u);
+	EXPECT_EQ(loaded_config["section"]["opt"].get<string_ini_t>(), " val ");
+	std::vector<std::string> expected_list{"a,b", "c ; not comment"};
+	EXPECT_EQ(loaded_config["section"]["escaped"].get_list<string_ini_t>(), expected_list);
+	expected_list = {"v1", "v2", "v3"};
+	EXPECT_EQ(loaded_config["section"]["list"].get_list<string_ini_t>(), expected_list);
+
+	// stream and buffer loading has to give the same results
+	std::istringstream stream{std::string(view)};
+	EXPECT_EQ(parser::load(stream), loaded_config);
+
+	EXPECT_THROW(parser::load(std::string_view("[section\n")), parser_exception);
+	EXPECT_THROW(parser::load(std::string_view("opt = val\n")), parser_exception);
+}
+
+TEST(parser, load_config_file)
+{
+	std::string file_name = "inicpp_parser_test.ini";
+	std::string str_config = ""
+							 "[section]\n"
+							 "opt = val\n"
+							 "opt2 = val2, val3\n"
+							 "[section2]\n"
+							 "link = ${section#opt}";
+	{
+		std::ofstream output(file_name);
+		output << str_config;
+	}
+	EXPECT_EQ(parser::load_file(file_name), parser::load(str_config));
+
+	// empty file cannot be mapped, stream reading is used instead
+	{
+		std::ofstream output(file_name, std::ios::trunc);
+	}
+	EXPECT_EQ(parser::load_file(file_name).size(), 0u);
+
+	std::remove(file_name.c_str());
+}
+
+TEST(parser, save_config_file)
+{
+	std::string file_name = "inicpp_parser_save_test.ini";
+	config first = parser::load("[section]\nopt = first\n");
+	config second = parser::load("[section]\nopt = second value\nother = 1, 2, 3\n");
+
+	parser::save(first, file_name);
+	EXPECT_EQ(parser::load_file(file_name), first);
+	EXPECT_THROW(parser::save(first, "nonexisting_directory/file.ini"), parser_exception);
+
+	save_params params;
+	params.atomic = true;
+	params.sync_directory = true;
+	EXPECT_THROW(parser::save(first, "nonexisting_directory/file.ini", params), parser_exception);
+
+#if defined(__unix__) || defined(__APPLE__)
+	// replaced file keeps its permissions and no temporary file is left
+	chmod(file_name.c_str(), 0640);
+	parser::save(second, file_name, params);
+	EXPECT_EQ(parser::load_file(file_name), second);
+	struct stat info;
+	ASSERT_EQ(stat(file_name.c_str(), &info), 0);
+	EXPECT_EQ(info.st_mode & 0777, 0640u);
+
+	DIR *directory = opendir(".");
+	ASSERT_NE(directory, nullptr);
+	while (dirent *entry = readdir(directory)) {
+		EXPECT_EQ(std::string(entry->d_name).find(file_name + ".tmp"), std::string::npos);
+	}
+	closedir(directory);
+#endif
+
+	// concurrent reader never sees partially written file
+	std::atomic<bool> done(false);
+	std::thread reader([&]() {
+		while (!done) {
+			config loaded = parser::load_file(file_name);
+			ASSERT_TRUE(loaded == first || loaded == second);
+		}
+	});
+	for (size_t i = 0; i < 100; ++i) {
+		parser::save(i % 2 == 0 ? first : second, file_name, params);
+	}
+	done = true;
+	reader.join();
+
+	std::remove(file_name.c_str());
+}
+
+TEST(parser, identifier_rules)
+{
+	std::string str_config = ""
+							 "[1section]\n"
+							 "opt#1 = val\n";
+	EXPECT_THROW(parser::load(str_config), parser_exception);
+
+	load_params params;
+	params.identifiers = identifier_validator("a-z0-9", "a-z0-9#");
+	auto loaded_config = parser::load(str_config, params);
+	EXPECT_EQ(loaded_config["1section"]["opt#1"].get<string_ini_t>(), "val");
+
+	params.identifiers = identifier_validator("a-z", "a-z");
+	EXPECT_THROW(parser::load("[section]\nOpt = val", params), parser_exception);
+}
+
+TEST(parser, parallel_load)
+{
+	// large enough input to be split between several threads
+	std::string str_config = "; routing table\n";
+	for (size_t i = 0; i < 5000; ++i) {
+		std::string name = "route" + std::to_string(i);
+		str_config += "[" + name + "]\n";
+		str_config += "gateway = 10.0." + std::to_string(i % 256) + ".1 ; comment\n";
+		str_config += "metrics = 1, 2, 3\n";
+		str_config += "local = ${" + name + "#gateway}\n";
+		if (i > 0) {
+			str_config += "previous = ${route" + std::to_string(i - 1) + "#local}\n";
+		}
+	}
+
+	load_params params;
+	params.threads = 4;
+	config sequential = parser::load(str_config);
+	config parallel = parser::load(str_config, params);
+	EXPECT_EQ(parallel, sequential);
+	EXPECT_EQ(parallel.size(), 5000u);
+	EXPECT_EQ(parallel["route4999"]["previous"].get<string_ini_t>(), "10.0.134.1");
+
+	// index policy does not change loaded contents
+	params.index = index_policy::hashed;
+	EXPECT_EQ(parser::load(str_config, params), sequential);
+	params.threads = 1;
+	config hashed = parser::load(str_config, params);
+	EXPECT_EQ(hashed, sequential);
+	EXPECT_EQ(hashed["route17"]["local"].get<string_ini_t>(), "10.0.17.1");
+	params.threads = 4;
+	params.index = index_policy::ordered;
+
+	// the same error as in sequential loading is reported
+	auto error = [](const std::string &str, const load_params &params) -> std::string {
+		try {
+			parser::load(str, params);
+		} catch (exception &e) {
+			return e.what();
+		}
+		return "";
+	};
+	std::string forward_link = str_config + "[last]\nlink = ${route0#missing}\n";
+	EXPECT_EQ(error(forward_link, params), "Option name in link not found on line 25002");
+	EXPECT_EQ(error(forward_link, params), error(forward_link, load_params()));
+	std::string duplicate = str_config + "[route5]\n[bad\n";
+	EXPECT_EQ(error(duplicate, params), "Section not ended on line 25002");
+	duplicate = str_config + "[route5]\n";
+	EXPECT_EQ(error(duplicate, params), error(duplicate, load_params()));
+}
+
+TEST(parser, link_resolution)
+{
+	// links can point forward and through other links
+	std::string str_config = "[first]\n"
+							 "a = ${second#b}\n"
+							 "c = ${first#a}, ${second#d}\n"
+							 "[second]\n"
+							 "b = ${second#d}\n"
+							 "d = value, other\n";
+	config cfg = parser::load(str_config);
+	EXPECT_EQ(cfg["first"]["a"].get<string_ini_t>(), "value");
+	EXPECT_EQ(cfg["first"]["c"].get_list<string_ini_t>(), std::vector<string_ini_t>({"value", "value"}));
+	EXPECT_EQ(cfg["second"]["b"].get<string_ini_t>(), "value");
+
+	// many references to one chain of links
+	std::string chain = "[templates]\nbase = 42\n";
+	for (size_t i = 1; i < 1000; ++i) {
+		chain += "t" + std::to_string(i) + " = ${templates#" + (i == 1 ? "base" : "t" + std::to_string(i - 1)) + "}\n";
+	}
+	chain += "[users]\n";
+	for (size_t i = 0; i < 1000; ++i) {
+		chain += "u" + std::to_string(i) + " = ${templates#t999}\n";
+	}
+	cfg = parser::load(chain);
+	EXPECT_EQ(cfg["users"]["u999"].get<signed_ini_t>(), 42);
+
+	auto error = [](const std::string &str) -> std::string {
+		try {
+			parser::load(str);
+		} catch (parser_exception &e) {
+			return e.what();
+		}
+		return "";
+	};
+	EXPECT_EQ(error("[s]\na = ${s#b}\nb = ${t#c}\n[t]\nc = ${s#a}\n"), "Cyclic link on line 5");
+	EXPECT_EQ(error("[s]\na = ${s#a}\n"), "Cyclic link on line 2");
+	EXPECT_EQ(error("[s]\na = 1\nb = ${x#a}\n"), "Bad link on line 3");
+	EXPECT_EQ(error("[s]\na = 1\nb = ${s#c}\n"), "Option name in link not found on line 3");
+}
+
+TEST(parser, typed_load)
+{
+	schema schm;
+	section_schema_params sect_params;
+	sect_params.name = "sect";
+	schm.add_section(sect_params);
+	option_schema_params<signed_ini_t> number_params;
+	number_params.name = "number";
+	number_params.validator = [](signed_ini_t value) { return value > 0; };
+	schm.add_option("sect", number_params);
+	option_schema_params<float_ini_t> list_params;
+	list_params.name = "list";
+	list_params.type = option_item::list;
+	schm.add_option("sect", list_params);
+	option_schema_params<boolean_ini_t> linked_params;
+	linked_params.name = "linked";
+	schm.add_option("sect", linked_params);
+
+	// values are parsed while loading, result is the same as validation of loaded config
+	std::string str_config = "[sect]\n"
+							 "number = 0x10\n"
+							 "list = 1.5, -2\n"
+							 "linked = ${other#flag}\n"
+							 "extra = 7\n"
+							 "[other]\n"
+							 "flag = on\n";
+	config cfg = parser::load(str_config, schm, schema_mode::relaxed);
+	config validated = parser::load(str_config);
+	validated.validate(schm, schema_mode::relaxed);
+	EXPECT_EQ(cfg, validated);
+	EXPECT_EQ(cfg["sect"]["number"].get_type(), option_type::signed_e);
+	EXPECT_EQ(cfg["sect"]["list"].get_list<float_ini_t>(), std::vector<float_ini_t>({1.5, -2}));
+	EXPECT_TRUE(cfg["sect"]["linked"].get<boolean_ini_t>());
+	EXPECT_EQ(cfg["sect"]["extra"].get_type(), option_type::string_e);
+
+	// links to typed options get their text, the same as without schema
+	option_schema_params<float_ini_t> ratio_params;
+	ratio_params.name = "ratio";
+	ratio_params.requirement = item_requirement::optional;
+	schm.add_option("sect", ratio_params);
+	option_schema_params<string_ini_t> text_params;
+	text_params.name = "text";
+	text_params.type = option_item::list;
+	text_params.requirement = item_requirement::optional;
+	schm.add_option("sect", text_params);
+	str_config = "[sect]\n"
+				 "number = 0x10\n"
+				 "list = ${sect#ratio}, 2\n"
+				 "linked = ${sect#flag}\n"
+				 "text = ${sect#flag}, ${sect#ratio}, ${sect#number}\n"
+				 "ratio = 0.123456789\n"
+				 "flag = yes\n";
+	option_schema_params<boolean_ini_t> flag_params;
+	flag_params.name = "flag";
+	flag_params.requirement = item_requirement::optional;
+	schm.add_option("sect", flag_params);
+	cfg = parser::load(str_config, schm, schema_mode::relaxed);
+	validated = parser::load(str_config);
+	validated.validate(schm, schema_mode::relaxed);
+	EXPECT_EQ(cfg, validated);
+	EXPECT_EQ(cfg["sect"]["text"].get_list<string_ini_t>(), std::vector<std::string>({"yes", "0.123456789", "0x10"}));
+	EXPECT_EQ(cfg["sect"]["list"].get_list<float_ini_t>(), std::vector<float_ini_t>({0.123456789, 2}));
+	EXPECT_EQ(cfg["sect"]["ratio"].get<float_ini_t>(), 0.123456789);
+
+	// wrong number of values is reported before wrong types
+	EXPECT_THROW(parser::load("[sect]\nnumber = a, b\nlist = 1\nlinked = 1\n", schm, schema_mode::relaxed),
+		validation_exception);
+	EXPECT_THROW(parser::load("[sect]\nnumber = a\nlist = 1, 2\nlinked = 1\n", schm, schema_mode::relaxed),
+		invalid_type_exception);
+	EXPECT_THROW(parser::load("[sect]\nnumber = -1\nlist = 1, 2\nlinked = 1\n", schm, schema_mode::relaxed),
+		validation_exception);
+}
+
+TEST(parser, adversarial_lists)
+{
+	// every input here takes minutes if splitting or unescaping is quadratic
+	const size_t count = 1 << 18;
+
+	std::string long_list = "[s]\nlist = 0";
+	for (size_t i = 1; i < count; ++i) {
+		long_list += ", " + std::to_string(i % 10);
+	}
+	config cfg = parser::load(long_list);
+	auto values = cfg["s"]["list"].get_list<string_ini_t>();
+	ASSERT_EQ(values.size(), count);
+	EXPECT_EQ(values[count - 1], std::to_string((count - 1) % 10));
+
+	// only escaped delimiters, whole value is one item
+	std::string escaped_commas = "[s]\nvalue = ";
+	for (size_t i = 0; i < count; ++i) {
+		escaped_commas += "\\,";
+	}
+	cfg = parser::load(escaped_commas);
+	EXPECT_EQ(cfg["s"]["value"].get<string_ini_t>(), std::string(count, ','));
+
+	// backslashes which escape each other
+	std::string backslashes = "[s]\nvalue = x" + std::string(2 * count, '\\') + "y";
+	cfg = parser::load(backslashes);
+	EXPECT_EQ(cfg["s"]["value"].get<string_ini_t>(), "x" + std::string(count, '\\') + "y");
+
+	// colons are delimiters if there is no comma, many empty items
+	std::string colons = "[s]\nvalue = a" + std::string(count, ':');
+	cfg = parser::load(colons);
+	values = cfg["s"]["value"].get_list<string_ini_t>();
+	ASSERT_EQ(values.size(), count + 1);
+	EXPECT_EQ(values[0], "a");
+	EXPECT_EQ(values[count], "");
+}
@@ -0,0 +1,119 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "push_parser.h"
+
+using namespace inicpp;
+
+
+/**
+ * Render config to text, so configs can be compared.
+ */
+static std::string dump(const config &cfg)
+{
+	std::ostringstream str;
+	str << cfg;
+	return str.str();
+}
+
+
+TEST(push_parser, chunked_input)
+{
+	std::string str = "; comment\n"
+					  "[section]\n"
+					  "a = 1, 2, 3 ; comment\n"
+					  "b = esc\\,aped\\ \n"
+					  "\n"
+					  "[other section]\n"
+					  "c = ${section#a}\n"
+					  "d = last";
+	std::string expected = dump(parser::load(str));
+
+	// every possible chunk size has to give the same result
+	for (size_t chunk = 1; chunk <= str.length(); ++chunk) {
+		config_builder builder;
+		push_parser push(builder);
+		for (size_t i = 0; i < str.length(); i += chunk) {
+			push.feed(str.data() + i, std::min(chunk, str.length() - i));
+		}
+		push.finish();
+		EXPECT_EQ(dump(builder.build()), expected) << "chunk size " << chunk;
+	}
+}
+
+TEST(push_parser, events_and_reuse)
+{
+	class counting_handler : public parse_handler
+	{
+	public:
+		size_t sections = 0;
+		std::vector<size_t> option_lines;
+
+		void on_section(std::string_view) override
+		{
+			sections++;
+		}
+
+		void on_option(std::string_view, std::vector<std::string> &) override
+		{
+			option_lines.push_back(get_line_number());
+		}
+	};
+
+	counting_handler handler;
+	push_parser push(handler);
+
+	// complete lines are reported immediately, incomplete one waits
+	push.feed("[sect]\nopt = val", 16);
+	EXPECT_EQ(handler.sections, 1u);
+	EXPECT_TRUE(handler.option_lines.empty());
+	push.feed("ue\n", 3);
+	EXPECT_EQ(handler.option_lines, std::vector<size_t>({2}));
+	push.feed("x = 1", 5);
+	push.finish();
+	EXPECT_EQ(handler.option_lines, std::vector<size_t>({2, 3}));
+
+	// parser is reset after finish, so line numbers start again
+	EXPECT_THROW(push.feed("opt = 1\n", 8), parser_exception);
+	push.finish();
+	push.feed("[next]\nopt = 1\n", 15);
+	EXPECT_EQ(handler.sections, 2u);
+	EXPECT_EQ(handler.option_lines, std::vector<size_t>({2, 3, 2}));
+
+	config_builder builder;
+	push_parser failing(builder);
+	failing.feed("[s]\nnot option", 14);
+	EXPECT_THROW(failing.feed("\n", 1), parser_exception);
+}
+
+TEST(push_parser, failed_line_is_dropped)
+{
+	class failing_handler : public parse_handler
+	{
+	public:
+		std::vector<std::string> names;
+
+		void on_option(std::string_view name, std::vector<std::string> &) override
+		{
+			if (name == "bad") {
+				throw parser_exception("Bad option");
+			}
+			names.emplace_back(name);
+		}
+	};
+
+	failing_handler handler;
+	push_parser push(handler);
+
+	// line which throws is not glued to the next chunk
+	push.feed("[sect]\nbad = ", 13);
+	EXPECT_THROW(push.feed("1\n", 2), parser_exception);
+	push.feed("good = 2\n", 9);
+	EXPECT_EQ(handler.names, std::vector<std::string>({"good"}));
+
+	// the same holds for the last line
+	push.feed("bad = 3", 7);
+	EXPECT_THROW(push.finish(), parser_exception);
+	EXPECT_NO_THROW(push.finish());
+	EXPECT_EQ(handler.names, std::vector<std::string>({"good"}));
+}
@@ -0,0 +1,131 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "exception.h"
+#include "scanner.h"
+
+using namespace inicpp;
+
+namespace
+{
+	/** Random text consisting mostly of structural characters */
+	std::string random_text(std::mt19937 &gen, size_t length)
+	{
+		const std::string alphabet = "a =;,:\\\n[]";
+		std::uniform_int_distribution<size_t> dist(0, alphabet.length() - 1);
+		std::string result;
+		for (size_t i = 0; i < length; ++i) {
+			result.push_back(alphabet[dist(gen)]);
+		}
+		return result;
+	}
+
+	/** Naive escaping resolution, same as parser did before scanner existed */
+	std::vector<bool> naive_escapes(const std::string &text)
+	{
+		std::vector<bool> result(text.length(), false);
+		bool escaped = false;
+		for (size_t i = 0; i < text.length(); ++i) {
+			if (escaped) {
+				result[i] = true;
+				escaped = false;
+			} else if (text[i] == '\\') {
+				escaped = true;
+			}
+		}
+		return result;
+	}
+}
+
+TEST(scanner, classifiers_agree)
+{
+	std::mt19937 gen(42);
+	auto classifiers = scanner::available_classifiers();
+	EXPECT_EQ(classifiers[0], "scalar");
+
+	for (size_t round = 0; round < 200; ++round) {
+		std::string block = random_text(gen, scanner::block_size);
+		raw_scan_block expected;
+		scanner::classify_scalar(block.data(), expected);
+
+		for (auto &name : classifiers) {
+			raw_scan_block result;
+			scanner::classify_with(name, block.data(), result);
+			EXPECT_EQ(result.newline, expected.newline) << name;
+			EXPECT_EQ(result.equals, expected.equals) << name;
+			EXPECT_EQ(result.semicolon, expected.semicolon) << name;
+			EXPECT_EQ(result.comma, expected.comma) << name;
+			EXPECT_EQ(result.colon, expected.colon) << name;
+			EXPECT_EQ(result.backslash, expected.backslash) << name;
+		}
+	}
+
+	raw_scan_block block;
+	EXPECT_THROW(scanner::classify_with("unknown", "", block), not_found_exception);
+}
+
+TEST(scanner, find_nonescaped)
+{
+	std::mt19937 gen(7);
+	scanner sc;
+
+	for (size_t round = 0; round < 100; ++round) {
+		std::string text = random_text(gen, round * 7);
+		auto escapes = naive_escapes(text);
+		sc.reset(text);
+
+		for (size_t i = 0; i < text.length(); ++i) {
+			EXPECT_EQ(sc.is_escaped(i), escapes[i]);
+		}
+
+		for (char ch : std::string("\n=;,:")) {
+			scan_class cls = scan_class::newline;
+			switch (ch) {
+			case '=': cls = scan_class::equals; break;
+			case ';': cls = scan_class::semicolon; break;
+			case ',': cls = scan_class::comma; break;
+			case ':': cls = scan_class::colon; break;
+			}
+
+			for (size_t from = 0; from < text.length(); from += 13) {
+				size_t to = std::min(text.length(), from + round * 3 + 1);
+				size_t expected = scanner::npos;
+				size_t expected_count = 0;
+				for (size_t i = from; i < to; ++i) {
+					if (text[i] == ch && (ch == '\n' || !escapes[i])) {
+						expected = std::min(expected, i);
+						expected_count++;
+					}
+				}
+				EXPECT_EQ(sc.find(cls, from, to), expected);
+				EXPECT_EQ(sc.count(cls, from, to), expected_count);
+			}
+		}
+	}
+}
+
+TEST(scanner, release_blocks)
+{
+	std::string text(1000, 'a');
+	text[100] = '\\';
+	text[101] = '=';
+	// escaping is carried over block boundary
+	text[127] = '\\';
+	text[128] = ';';
+	text[700] = '=';
+	text[800] = ';';
+
+	scanner sc;
+	sc.reset(text);
+	EXPECT_EQ(sc.find(scan_class::equals, 0, text.length()), 700u);
+	EXPECT_TRUE(sc.is_escaped(128));
+	EXPECT_EQ(sc.find(scan_class::semicolon, 0, 700), scanner::npos);
+
+	// released blocks are not needed for further scanning
+	sc.release(600);
+	EXPECT_EQ(sc.find(scan_class::equals, 650, text.length()), 700u);
+	EXPECT_EQ(sc.find(scan_class::semicolon, 650, text.length()), 800u);
+	EXPECT_FALSE(sc.is_escaped(999));
+}
@@ -36,6 +36,28 @@ TEST(schema, creation_and_assignments)
 	EXPECT_TRUE(move_assigned.contains("name"));
 }
 
+TEST(schema, moves_and_emplace)
+{
+	static_assert(std::is_nothrow_move_constructible<schema>::value, "schema move may throw");
+	static_assert(std::is_nothrow_move_constructible<section_schema>::value, "section_schema move may throw");
+	static_assert(std::is_nothrow_move_constructible<option_schema>::value, "option_schema move may throw");
+
+	// moved schemas keep their contents
+	schema schm;
+	section_schema_params other_params;
+	other_params.name = "other";
+	section_schema other(other_params);
+	option_schema_params<signed_ini_t> opt_params;
+	opt_params.name = "opt";
+	other.add_option(option_schema(opt_params));
+	schm.add_section(std::move(other));
+	EXPECT_TRUE(schm["other"].contains("opt"));
+	opt_params.name = "opt2";
+	schm.add_option("other", option_schema(opt_params));
+	EXPECT_TRUE(schm["other"].contains("opt2"));
+	EXPECT_THROW(schm.add_option("other", option_schema(opt_params)), ambiguity_exception);
+}
+
 TEST(schema, adding_and_querying_sections)
 {
 	// create testing section in schema
@@ -61,6 +83,10 @@ TEST(schema, adding_and_querying_sections)
 	EXPECT_EQ(schm["name"].get_name(), "name");
 	EXPECT_EQ(schm["other"].get_name(), "other");
 	EXPECT_THROW(schm["random"].get_name(), not_found_exception);
+
+	// find does not throw
+	EXPECT_EQ(schm.find("other"), &schm["other"]);
+	EXPECT_EQ(static_cast<const schema &>(schm).find("random"), nullptr);
 }
 
 TEST(schema, adding_and_querying_options)
@@ -80,6 +106,8 @@ TEST(schema, adding_and_querying_options)
 	EXPECT_EQ(schm["name"].size(), 1u);
 	EXPECT_THROW(schm.add_option("name", opt1_params), ambiguity_exception);
 	EXPECT_THROW(schm.add_option("random", opt1_params), not_found_exception);
+	EXPECT_EQ(schm["name"].find("opt1"), &schm["name"]["opt1"]);
+	EXPECT_EQ(schm["name"].find("opt2"), nullptr);
 }
 
 TEST(schema, validate_config)
@@ -41,6 +41,29 @@ TEST(section, adding_and_removing_options)
 	EXPECT_EQ(sect[0].get_name(), "opt2");
 }
 
+TEST(section, hashed_index)
+{
+	section sect("name", index_policy::hashed);
+	for (int i = 0; i < 100; ++i) {
+		sect.add_option<signed_ini_t>("opt" + std::to_string(i), i);
+	}
+	EXPECT_THROW(sect.add_option<signed_ini_t>("opt7", 7), ambiguity_exception);
+	EXPECT_EQ(sect["opt42"].get<signed_ini_t>(), 42);
+	sect.remove_option("opt0");
+	EXPECT_FALSE(sect.contains("opt0"));
+	EXPECT_EQ(sect[0].get_name(), "opt1");
+	EXPECT_EQ(sect["opt99"].get<signed_ini_t>(), 99);
+
+	// copies keep the policy and order
+	section copy(sect);
+	EXPECT_EQ(copy, sect);
+	EXPECT_EQ(copy["opt50"].get<signed_ini_t>(), 50);
+	copy.add_option<signed_ini_t>("new", 1);
+	EXPECT_EQ(copy[copy.size() - 1].get_name(), "new");
+	EXPECT_TRUE(copy.contains("new"));
+	EXPECT_FALSE(sect.contains("new"));
+}
+
 TEST(section, iterators)
 {
 	section sect("name");
@@ -0,0 +1,84 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "parser.h"
+#include "selection.h"
+
+using namespace inicpp;
+
+
+TEST(selection, predicates)
+{
+	selection all;
+	EXPECT_TRUE(all.selects_all());
+	EXPECT_TRUE(all.contains_section("any"));
+	EXPECT_TRUE(all.contains_option("any", "option"));
+
+	selection names = {"logging", "metrics"};
+	EXPECT_FALSE(names.selects_all());
+	EXPECT_FALSE(names.filters_options());
+	EXPECT_TRUE(names.contains_section("metrics"));
+	EXPECT_FALSE(names.contains_section("routes"));
+
+	selection custom([](std::string_view name) { return name.substr(0, 3) == "log"; },
+		[](std::string_view, std::string_view option) { return option != "secret"; });
+	EXPECT_TRUE(custom.contains_section("logging"));
+	EXPECT_FALSE(custom.contains_section("metrics"));
+	EXPECT_TRUE(custom.filters_options());
+	EXPECT_FALSE(custom.contains_option("logging", "secret"));
+
+	schema schm;
+	section_schema_params sect_params;
+	sect_params.name = "logging";
+	schm.add_section(sect_params);
+	option_schema_params<string_ini_t> opt_params;
+	opt_params.name = "level";
+	schm.add_option("logging", opt_params);
+	selection by_schema(schm);
+	EXPECT_TRUE(by_schema.contains_section("logging"));
+	EXPECT_FALSE(by_schema.contains_section("metrics"));
+	EXPECT_TRUE(by_schema.contains_option("logging", "level"));
+	EXPECT_FALSE(by_schema.contains_option("logging", "file"));
+}
+
+TEST(selection, load)
+{
+	// skipped sections are not even lexed, so errors in them are not reported
+	std::string str_config = "[routes]\n"
+							 "this is not valid\n"
+							 "a = ${missing#link}\n"
+							 "long = " + std::string(200, 'x') + "\\\\\\\n"
+							 "[logging]\n"
+							 "level = debug ; comment\n"
+							 "file = /var/log/app.log\n"
+							 " [huge]\n"
+							 "data = 1, 2, 3\n"
+							 "[metrics]\n"
+							 "port = 9100\n"
+							 "level = ${logging#level}\n";
+
+	config cfg = parser::load(str_config, selection({"logging", "metrics"}));
+	EXPECT_EQ(cfg.size(), 2u);
+	EXPECT_EQ(cfg["logging"].size(), 2u);
+	EXPECT_EQ(cfg["metrics"]["level"].get<string_ini_t>(), "debug");
+
+	// stream input skips the same sections
+	std::istringstream stream{str_config};
+	EXPECT_EQ(parser::load(stream, selection({"logging", "metrics"})), cfg);
+
+	// options can be filtered too
+	selection levels([](std::string_view) { return true; },
+		[](std::string_view, std::string_view option) { return option == "level"; });
+	EXPECT_THROW(parser::load(str_config, levels), parser_exception);
+	cfg = parser::load(str_config.substr(str_config.find("[logging]")), levels);
+	EXPECT_EQ(cfg.size(), 3u);
+	EXPECT_EQ(cfg["logging"].size(), 1u);
+	EXPECT_EQ(cfg["huge"].size(), 0u);
+	EXPECT_EQ(cfg["metrics"]["level"].get<string_ini_t>(), "debug");
+
+	// header of skipped section still ends selected section
+	cfg = parser::load("[a]\nx = 1\n[b]\ny = 2\n[c]\nz = 3", selection({"a", "c"}));
+	EXPECT_EQ(cfg.size(), 2u);
+	EXPECT_EQ(cfg["a"].size(), 1u);
+	EXPECT_EQ(cfg["c"]["z"].get<signed_ini_t>(), 3);
+}
@@ -0,0 +1,269 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "parser.h"
+#include "serializer.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace inicpp;
+
+
+namespace
+{
+	config typed_config()
+	{
+		config cfg;
+		section &sect = cfg.emplace_section("typed");
+		sect.add_option<boolean_ini_t>("flag", false);
+		sect.emplace_option("numbers").set_list<signed_ini_t>({-3, 0, 9223372036854775807});
+		sect.add_option<unsigned_ini_t>("size", 18446744073709551615u);
+		sect.emplace_option("ratios").set_list<float_ini_t>({0.1, -2.5e-7, 1e21, 100, 0.1 + 0.2});
+		sect.add_option<enum_ini_t>("mode", " fast ");
+		sect.emplace_option("texts", std::vector<std::string>{" a", "b ", " "});
+		cfg.emplace_section("empty");
+		return cfg;
+	}
+}
+
+TEST(serializer, value_formatting)
+{
+	std::string output;
+	serializer(output).write(typed_config());
+	EXPECT_EQ(output,
+		"[typed]\n"
+		"flag = no\n"
+		"numbers = -3,0,9223372036854775807\n"
+		"size = 18446744073709551615\n"
+		"ratios = 0.1,-2.5e-07,1e+21,100,0.30000000000000004\n"
+		"mode = \\ fast\\ \n"
+		"texts = \\ a,b\\ ,\\ \n"
+		"[empty]\n");
+
+	// string sink appends to existing content
+	serializer(output).write_section_name("next");
+	EXPECT_EQ(output.substr(output.size() - 7), "[next]\n");
+}
+
+TEST(serializer, same_output_as_before)
+{
+	// expected texts were written by stream operators before the serializer was introduced
+	config cfg;
+	section &sect = cfg.emplace_section("typed");
+	sect.add_option<boolean_ini_t>("flag", false);
+	sect.emplace_option("numbers").set_list<signed_ini_t>({-3, 0, 9223372036854775807});
+	sect.add_option<unsigned_ini_t>("size", 18446744073709551615u);
+	sect.emplace_option("ratios").set_list<float_ini_t>({0.5, -2.25, 100});
+	sect.add_option<enum_ini_t>("mode", " fast ");
+	sect.emplace_option("texts", std::vector<std::string>{" a", "b ", ";x", "c,d", "e\\f", "g:h", "${typed#flag}"});
+	cfg.emplace_section("empty");
+	std::string cfg_text = "[typed]\n"
+						   "flag = no\n"
+						   "numbers = -3,0,9223372036854775807\n"
+						   "size = 18446744073709551615\n"
+						   "ratios = 0.5,-2.25,100\n"
+						   "mode = \\ fast\\ \n"
+						   "texts = \\ a,b\\ ,;x,c,d,e\\f,g:h,${typed#flag}\n"
+						   "[empty]\n";
+	std::string output;
+	serializer(output).write(cfg);
+	EXPECT_EQ(output, cfg_text);
+	std::ostringstream cfg_stream;
+	cfg_stream << cfg;
+	EXPECT_EQ(cfg_stream.str(), cfg_text);
+
+	// links are written resolved
+	config linked = parser::load("[a]\nx = 1, 2\n[b]\ny = ${a#x}\nz = esc\\,aped\\ , ${a#x} ; comment\n");
+	output.clear();
+	serializer(output).write(linked);
+	EXPECT_EQ(output, "[a]\nx = 1,2\n[b]\ny = 1\nz = esc,aped\\ ,1\n");
+
+	schema schm;
+	section_schema_params sect_params;
+	sect_params.name = "typed";
+	sect_params.comment = "first line\n\nthird line";
+	schm.add_section(sect_params);
+	sect_params.name = "optional";
+	sect_params.comment = "";
+	sect_params.requirement = item_requirement::optional;
+	schm.add_section(sect_params);
+	option_schema_params<unsigned_ini_t> size_params;
+	size_params.name = "size";
+	size_params.comment = "size of it";
+	schm.add_option("typed", size_params);
+	option_schema_params<signed_ini_t> missing_params;
+	missing_params.name = "missing";
+	missing_params.requirement = item_requirement::optional;
+	missing_params.default_value = "5";
+	schm.add_option("typed", missing_params);
+	option_schema_params<enum_ini_t> mode_params;
+	mode_params.name = "mode";
+	mode_params.type = option_item::list;
+	mode_params.requirement = item_requirement::optional;
+	mode_params.default_value = "a, b";
+	mode_params.comment = "modes";
+	schm.add_option("optional", mode_params);
+	option_schema_params<float_ini_t> ratio_params;
+	ratio_params.name = "ratio";
+	ratio_params.requirement = item_requirement::optional;
+	ratio_params.default_value = "0.5";
+	schm.add_option("optional", ratio_params);
+	option_schema_params<boolean_ini_t> flag_params;
+	flag_params.name = "flag";
+	schm.add_option("optional", flag_params);
+	option_schema_params<string_ini_t> text_params;
+	text_params.name = "text";
+	text_params.requirement = item_requirement::optional;
+	text_params.default_value = "x;y";
+	schm.add_option("optional", text_params);
+	std::string schema_text = ";first line\n"
+							  ";\n"
+							  ";third line\n"
+							  ";<mandatory>\n"
+							  "[typed]\n"
+							  ";size of it\n"
+							  ";<mandatory, single>\n"
+							  ";<default value: \"\">\n"
+							  "size = \n"
+							  ";<optional, single>\n"
+							  ";<default value: \"5\">\n"
+							  "missing = 5\n"
+							  ";<optional>\n"
+							  "[optional]\n"
+							  ";modes\n"
+							  ";<optional, list>\n"
+							  ";<default value: \"a, b\">\n"
+							  "mode = a, b\n"
+							  ";<optional, single>\n"
+							  ";<default value: \"0.5\">\n"
+							  "ratio = 0.5\n"
+							  ";<mandatory, single>\n"
+							  ";<default value: \"\">\n"
+							  "flag = \n"
+							  ";<optional, single>\n"
+							  ";<default value: \"x;y\">\n"
+							  "text = x;y\n";
+	output.clear();
+	serializer(output).write(schm);
+	EXPECT_EQ(output, schema_text);
+	std::ostringstream schema_stream;
+	schema_stream << schm;
+	EXPECT_EQ(schema_stream.str(), schema_text);
+
+	// config with schema comments and defaults of missing options
+	std::string saved_text = ";first line\n"
+							 ";\n"
+							 ";third line\n"
+							 ";<mandatory>\n"
+							 "[typed]\n"
+							 "flag = no\n"
+							 "numbers = -3,0,9223372036854775807\n"
+							 ";size of it\n"
+							 ";<mandatory, single>\n"
+							 ";<default value: \"\">\n"
+							 "size = 18446744073709551615\n"
+							 "ratios = 0.5,-2.25,100\n"
+							 "mode = \\ fast\\ \n"
+							 "texts = \\ a,b\\ ,;x,c,d,e\\f,g:h,${typed#flag}\n"
+							 ";<optional, single>\n"
+							 ";<default value: \"5\">\n"
+							 "missing = 5\n"
+							 "[empty]\n";
+	output.clear();
+	serializer(output).write(cfg, schm);
+	EXPECT_EQ(output, saved_text);
+	std::ostringstream saved;
+	parser::save(cfg, schm, saved);
+	EXPECT_EQ(saved.str(), saved_text);
+}
+
+TEST(serializer, float_round_trip)
+{
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<float_ini_t> exponent(-300, 300);
+	std::vector<float_ini_t> values;
+	for (size_t i = 0; i < 10000; ++i) {
+		values.push_back((i % 2 == 0 ? 1 : -1) * std::pow(10.0, exponent(generator)));
+	}
+	config cfg;
+	cfg.emplace_section("numbers").emplace_option("values").set_list<float_ini_t>(values);
+
+	// saved and loaded values are exactly the same
+	schema schm;
+	section_schema_params sect_params;
+	sect_params.name = "numbers";
+	schm.add_section(sect_params);
+	option_schema_params<float_ini_t> opt_params;
+	opt_params.name = "values";
+	opt_params.type = option_item::list;
+	schm.add_option("numbers", opt_params);
+
+	std::ostringstream str;
+	parser::save(cfg, str);
+	config loaded = parser::load(str.str(), schm, schema_mode::strict);
+	EXPECT_EQ(loaded["numbers"]["values"].get_list<float_ini_t>(), values);
+}
+
+TEST(serializer, buffered_stream)
+{
+	config cfg = typed_config();
+	std::string expected;
+	serializer(expected).write(cfg);
+
+	// small buffer is emitted many times, the output is the same
+	std::ostringstream str;
+	{
+		serializer output(str, 16);
+		for (int i = 0; i < 10; ++i) {
+			output.write(cfg);
+		}
+		EXPECT_LT(str.str().size(), expected.size() * 10);
+		output.flush();
+		EXPECT_EQ(str.str().size(), expected.size() * 10);
+	}
+	EXPECT_EQ(str.str().substr(0, expected.size()), expected);
+
+	// failed stream is reported by flush
+	std::ostringstream failed;
+	failed.setstate(std::ios::badbit);
+	serializer failed_output(failed);
+	failed_output.write(cfg);
+	EXPECT_THROW(failed_output.flush(), parser_exception);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(serializer, file_descriptor)
+{
+	std::string file_name = "inicpp_serializer_test.ini";
+	config cfg = typed_config();
+	int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	ASSERT_GE(fd, 0);
+	{
+		serializer output(fd);
+		output.write(cfg);
+	}
+	close(fd);
+	std::string expected;
+	serializer(expected).write(cfg);
+	std::ifstream input(file_name);
+	std::ostringstream written;
+	written << input.rdbuf();
+	EXPECT_EQ(written.str(), expected);
+
+	std::remove(file_name.c_str());
+
+	// writing to invalid descriptor fails
+	serializer invalid(-1);
+	invalid.write(cfg);
+	EXPECT_THROW(invalid.flush(), parser_exception);
+}
+#endif
@@ -0,0 +1,137 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <sstream>
+#include <type_traits>
+
+#include "parser.h"
+#include "snapshot.h"
+
+using namespace inicpp;
+
+
+namespace
+{
+	config typed_config()
+	{
+		config cfg = parser::load("[numbers]\n"
+								  "signed = -5, 7\n"
+								  "unsigned = 42\n"
+								  "float = 2.5\n"
+								  "[flags]\n"
+								  "enabled = on\n"
+								  "name = value with spaces\n"
+								  "mode = fast\n"
+								  "[untyped]\n"
+								  "z = 1\n"
+								  "a = text\n");
+
+		schema schm;
+		section_schema_params numbers_params;
+		numbers_params.name = "numbers";
+		schm.add_section(numbers_params);
+		section_schema_params flags_params;
+		flags_params.name = "flags";
+		schm.add_section(flags_params);
+
+		option_schema_params<signed_ini_t> signed_params;
+		signed_params.name = "signed";
+		signed_params.type = option_item::list;
+		schm.add_option("numbers", signed_params);
+		option_schema_params<unsigned_ini_t> unsigned_params;
+		unsigned_params.name = "unsigned";
+		schm.add_option("numbers", unsigned_params);
+		option_schema_params<float_ini_t> float_params;
+		float_params.name = "float";
+		schm.add_option("numbers", float_params);
+		option_schema_params<boolean_ini_t> bool_params;
+		bool_params.name = "enabled";
+		schm.add_option("flags", bool_params);
+		option_schema_params<string_ini_t> string_params;
+		string_params.name = "name";
+		schm.add_option("flags", string_params);
+		option_schema_params<enum_ini_t> enum_params;
+		enum_params.name = "mode";
+		schm.add_option("flags", enum_params);
+
+		cfg.validate(schm, schema_mode::relaxed);
+		return cfg;
+	}
+}
+
+
+TEST(snapshot, round_trip)
+{
+	static_assert(std::is_nothrow_move_constructible<snapshot>::value, "snapshot move may throw");
+	static_assert(std::is_nothrow_move_assignable<snapshot>::value, "snapshot move may throw");
+
+	config cfg = typed_config();
+	std::ostringstream output;
+	snapshot::write(cfg, output);
+	snapshot snap = snapshot::load(output.str());
+
+	EXPECT_EQ(snap.size(), 3u);
+	EXPECT_EQ(snap.section_name(0), "numbers");
+	EXPECT_EQ(snap.section_name(2), "untyped");
+	EXPECT_THROW(snap.section_name(3), not_found_exception);
+	EXPECT_TRUE(snap.contains("flags"));
+	EXPECT_FALSE(snap.contains("missing"));
+	EXPECT_TRUE(snap.contains("untyped", "a"));
+	EXPECT_FALSE(snap.contains("untyped", "b"));
+	EXPECT_FALSE(snap.contains("missing", "a"));
+
+	// values are returned in their stored types
+	EXPECT_EQ(snap.get_type("numbers", "signed"), option_type::signed_e);
+	EXPECT_EQ(snap.get_list<signed_ini_t>("numbers", "signed"), std::vector<signed_ini_t>({-5, 7}));
+	EXPECT_EQ(snap.get<unsigned_ini_t>("numbers", "unsigned"), 42u);
+	EXPECT_DOUBLE_EQ(snap.get<float_ini_t>("numbers", "float"), 2.5);
+	EXPECT_TRUE(snap.get<boolean_ini_t>("flags", "enabled"));
+	EXPECT_EQ(snap.get<string_ini_t>("flags", "mode"), "fast");
+	EXPECT_EQ(snap.get_view("flags", "name"), "value with spaces");
+	EXPECT_EQ(snap.get<string_ini_t>("untyped", "z"), "1");
+	EXPECT_THROW(snap.get<signed_ini_t>("numbers", "float"), bad_cast_exception);
+	EXPECT_THROW(snap.get_view("numbers", "float"), bad_cast_exception);
+	EXPECT_THROW(snap.get_view("untyped", "a", 1), not_found_exception);
+	EXPECT_THROW(snap.get<signed_ini_t>("numbers", "missing"), not_found_exception);
+
+	// config created from snapshot is the same as the original one
+	EXPECT_EQ(snap.to_config(), cfg);
+	EXPECT_EQ(snapshot::load(output.str()).to_config()["flags"]["mode"].get_type(), option_type::enum_e);
+}
+
+TEST(snapshot, corrupted)
+{
+	std::ostringstream output;
+	snapshot::write(typed_config(), output);
+	std::string data = output.str();
+
+	EXPECT_THROW(snapshot::load(""), parser_exception);
+	EXPECT_THROW(snapshot::load(data.substr(0, data.size() - 1)), parser_exception);
+
+	std::string bad_magic = data;
+	bad_magic[0] = 'X';
+	EXPECT_THROW(snapshot::load(bad_magic), parser_exception);
+
+	// damaged content is found by checksum, which is verified only on request
+	std::string damaged = data;
+	damaged[damaged.size() - 1] ^= 1;
+	EXPECT_THROW(snapshot::load(damaged, true), parser_exception);
+	EXPECT_NO_THROW(snapshot::load(damaged));
+	EXPECT_NO_THROW(snapshot::load(data, true));
+}
+
+TEST(snapshot, file)
+{
+	std::string file_name = "inicpp_snapshot_test.snapshot";
+	config cfg = typed_config();
+	snapshot::write_file(cfg, file_name);
+
+	snapshot snap = snapshot::open(file_name);
+	snapshot moved = std::move(snap);
+	EXPECT_EQ(moved.get_list<signed_ini_t>("numbers", "signed"), std::vector<signed_ini_t>({-5, 7}));
+	EXPECT_EQ(moved.to_config(), cfg);
+
+	std::remove(file_name.c_str());
+	EXPECT_THROW(snapshot::open(file_name), parser_exception);
+}
@@ -1,6 +1,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
 #include "exception.h"
 #include "string_utils.h"
 
@@ -231,3 +236,108 @@ TEST(string_utils, parse_boolean_value)
 
 	EXPECT_THROW(string_utils::parse_string<boolean_ini_t>("random", ""), invalid_type_exception);
 }
+
+TEST(string_utils, parse_value)
+{
+	using string_utils::parse_status;
+	using string_utils::parse_value;
+
+	signed_ini_t signed_value = 0;
+	EXPECT_EQ(parse_value("-9223372036854775808", signed_value), parse_status::ok);
+	EXPECT_EQ(signed_value, std::numeric_limits<signed_ini_t>::min());
+	EXPECT_EQ(parse_value("9223372036854775808", signed_value), parse_status::out_of_range);
+	EXPECT_EQ(parse_value("+017", signed_value), parse_status::ok);
+	EXPECT_EQ(signed_value, 15);
+	EXPECT_EQ(parse_value("-0B101", signed_value), parse_status::ok);
+	EXPECT_EQ(signed_value, -5);
+	EXPECT_EQ(parse_value("12abc", signed_value), parse_status::invalid);
+	EXPECT_EQ(parse_value("09", signed_value), parse_status::invalid);
+	EXPECT_EQ(parse_value("0x", signed_value), parse_status::invalid);
+	EXPECT_EQ(parse_value("--1", signed_value), parse_status::invalid);
+	EXPECT_EQ(parse_value("", signed_value), parse_status::invalid);
+	EXPECT_EQ(signed_value, -5);
+
+	unsigned_ini_t unsigned_value = 0;
+	EXPECT_EQ(parse_value("0xFFFFFFFFFFFFFFFF", unsigned_value), parse_status::ok);
+	EXPECT_EQ(unsigned_value, std::numeric_limits<unsigned_ini_t>::max());
+	EXPECT_EQ(parse_value("0x10000000000000000", unsigned_value), parse_status::out_of_range);
+	EXPECT_EQ(parse_value("-1", unsigned_value), parse_status::out_of_range);
+	EXPECT_EQ(parse_value("0", unsigned_value), parse_status::ok);
+	EXPECT_EQ(unsigned_value, 0u);
+
+	// floats are correctly rounded
+	float_ini_t float_value = 0;
+	EXPECT_EQ(parse_value("0.1", float_value), parse_status::ok);
+	EXPECT_EQ(float_value, 0.1);
+	EXPECT_EQ(parse_value("-2.2250738585072014e-308", float_value), parse_status::ok);
+	EXPECT_EQ(float_value, -std::numeric_limits<float_ini_t>::min());
+	EXPECT_EQ(parse_value("0x1.8p1", float_value), parse_status::ok);
+	EXPECT_EQ(float_value, 3.0);
+	EXPECT_EQ(parse_value("-inf", float_value), parse_status::ok);
+	EXPECT_EQ(float_value, -std::numeric_limits<float_ini_t>::infinity());
+	EXPECT_EQ(parse_value("1e400", float_value), parse_status::out_of_range);
+	EXPECT_EQ(parse_value("1.5x", float_value), parse_status::invalid);
+	EXPECT_EQ(parse_value("+-1", float_value), parse_status::invalid);
+
+	boolean_ini_t boolean_value = false;
+	EXPECT_EQ(parse_value("enabled", boolean_value), parse_status::ok);
+	EXPECT_TRUE(boolean_value);
+	EXPECT_EQ(parse_value("of", boolean_value), parse_status::invalid);
+	EXPECT_EQ(parse_value("yess", boolean_value), parse_status::invalid);
+	EXPECT_EQ(parse_value("", boolean_value), parse_status::invalid);
+	EXPECT_TRUE(boolean_value);
+
+	EXPECT_THROW(string_utils::parse_string<signed_ini_t>("99999999999999999999", "opt"), invalid_type_exception);
+}
+
+TEST(string_utils, format_value)
+{
+	char buffer[max_formatted_length];
+	auto format = [&buffer](auto value) { return std::string(buffer, format_value(value, buffer)); };
+
+	EXPECT_EQ(format(std::numeric_limits<signed_ini_t>::min()), "-9223372036854775808");
+	EXPECT_EQ(format(std::numeric_limits<unsigned_ini_t>::max()), "18446744073709551615");
+
+	// floats are written in the shortest text which is read back exactly
+	EXPECT_EQ(format(52.4), "52.4");
+	EXPECT_EQ(format(0.1 + 0.2), "0.30000000000000004");
+	EXPECT_EQ(format(100.0), "100");
+	EXPECT_EQ(format(1e23), "1e+23");
+	EXPECT_EQ(format(-0.0), "-0");
+	EXPECT_EQ(format(std::numeric_limits<float_ini_t>::max()), "1.7976931348623157e+308");
+	EXPECT_EQ(format(std::numeric_limits<float_ini_t>::denorm_min()), "5e-324");
+	EXPECT_EQ(format(-std::numeric_limits<float_ini_t>::infinity()), "-inf");
+	EXPECT_EQ(format(std::numeric_limits<float_ini_t>::quiet_NaN()), "nan");
+}
+
+TEST(string_utils, float_round_trip)
+{
+	std::mt19937_64 generator(20161016);
+	std::uniform_real_distribution<float_ini_t> ordinary(-1e6, 1e6);
+	char buffer[max_formatted_length];
+	char longest[max_formatted_length];
+
+	for (size_t i = 0; i < 200000; ++i) {
+		// random bit patterns cover all exponents and subnormals, ordinary values common configs
+		float_ini_t value;
+		if (i % 2 == 0) {
+			uint64_t bits = generator();
+			std::memcpy(&value, &bits, sizeof(value));
+		} else {
+			value = ordinary(generator);
+		}
+
+		std::string_view text(buffer, format_value(value, buffer));
+		float_ini_t parsed = 0;
+		ASSERT_EQ(parse_value(text, parsed), parse_status::ok) << text;
+		if (std::isnan(value)) {
+			EXPECT_TRUE(std::isnan(parsed)) << text;
+			continue;
+		}
+		ASSERT_EQ(std::memcmp(&parsed, &value, sizeof(value)), 0) << text;
+
+		// never longer than 17 significant digits which always round trip
+		int longest_length = std::snprintf(longest, sizeof(longest), "%.17g", value);
+		EXPECT_LE(text.length(), static_cast<size_t>(longest_length)) << text;
+	}
+}